@@ -239,7 +239,7 @@ void Renderer3D::updatePiecesFromBoard(const Board& board) {
     }
     
     // Récupérer l'état actuel de l'échiquier
-    const std::vector<Piece>& boardState = board.getBoardState();
+    const std::vector<Piece> boardState = board.getBoardState();
     std::vector<ChessPiece> newState;
     
     // Convertir l'état 2D en représentation 3D
@@ -1,8 +1,15 @@
 #include "app.hpp"
 #include <imgui.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <ctime>
 #include <iostream>
 #include <string>
+#include <thread>
 #include "Chess/Board.hpp"
+#include "Chess/Core/San.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glad/glad.h>
@@ -17,6 +24,7 @@ void app::init() {
 void app::drawGameModeWindow() {
     if (ImGui::CollapsingHeader("Mode de Jeu")) {
         if (ImGui::Button("Mode Classique", ImVec2(150, 30))) {
+            resetAI();
             m_board = Board();
             m_board.setGameMode(std::make_unique<ClassicChessMode>());
             m_board.initializeBoard(&m_renderer3D);
@@ -25,6 +33,7 @@ void app::drawGameModeWindow() {
         ImGui::SameLine();
         
         if (ImGui::Button("Sous quelques grammes", ImVec2(200, 30))) {
+            resetAI();
             m_board = Board();
             m_board.setGameMode(std::make_unique<DrunkChessMode>());
             m_board.initializeBoard(&m_renderer3D);
@@ -33,6 +42,33 @@ void app::drawGameModeWindow() {
         ImGui::Separator();
         ImGui::Text("Mode actuel: %s", m_board.getCurrentModeName().c_str());
 
+        ImGui::InputText("FEN", m_fenInput, sizeof(m_fenInput));
+        if (ImGui::Button("Charger")) {
+            m_fenError = m_board.loadFen(m_fenInput);
+            if (m_fenError == FenError::None)
+                resetAI();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Copier la position")) {
+            char fen[FEN_MAX_LENGTH + 1];
+            fen[writeFen(m_board.getState(), fen)] = '\0';
+            ImGui::SetClipboardText(fen);
+            std::snprintf(m_fenInput, sizeof(m_fenInput), "%s", fen);
+        }
+        if (m_fenError != FenError::None)
+            ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "FEN refusée : %s", fenErrorName(m_fenError));
+
+        ImGui::InputText("Fichier PGN", m_pgnPath, sizeof(m_pgnPath));
+        if (ImGui::Button("Enregistrer la partie")) {
+            savePgn();
+        }
+        ImGui::SameLine();
+        ImGui::Text("%zu demi-coups", m_board.moveHistory().size());
+        if (m_pgnStatus > 0)
+            ImGui::Text("Partie enregistrée dans %s", m_pgnPath);
+        else if (m_pgnStatus < 0)
+            ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "Impossible d'écrire %s", m_pgnPath);
+
         ImGui::TextColored(ImVec4(1, 0, 0, 1), "Attention: L'abus d'alcool est dangereux pour la santé!");
         ImGui::TextColored(ImVec4(1, 0, 0, 1), "À consommer avec modération!");
     }
@@ -42,6 +78,333 @@ void app::drawGameModeWindow() {
     }
 }
 
+void app::savePgn() {
+    const std::time_t now = std::time(nullptr);
+    char              date[16];
+    std::strftime(date, sizeof(date), "%Y.%m.%d", std::localtime(&now));
+
+    const std::string mode   = m_board.getCurrentModeName();
+    const char*       white  = m_aiEnabled && m_aiColor == PieceColor::White ? "Ordinateur" : "Joueur";
+    const char*       black  = m_aiEnabled && m_aiColor == PieceColor::Black ? "Ordinateur" : "Joueur";
+    const PgnTag      tags[] = {{"Event", mode}, {"Site", "?"}, {"Date", date}, {"Round", "-"}, {"White", white}, {"Black", black}};
+
+    std::FILE* file = std::fopen(m_pgnPath, "wb");
+    bool       ok   = file && m_board.savePgn(file, tags, static_cast<int>(std::size(tags)));
+    if (file && std::fclose(file) != 0)
+        ok = false;
+    m_pgnStatus = ok ? 1 : -1;
+}
+
+// La recherche ne doit jamais survivre à la partie pour laquelle elle a été lancée
+void app::resetAI() {
+    m_ai.cancel();
+    m_ai.newGame();
+    m_aiReport      = {};
+    m_aiSearchedPly = static_cast<size_t>(-1);
+    m_aiSearchedKey = 0;
+    m_aiClockMs     = static_cast<int64_t>(m_aiBaseMinutes) * 60 * 1000;
+    m_aiPonderMove  = Move::none();
+}
+
+// Appelé à chaque image : lance la recherche quand c'est au tour de l'ordinateur, relève la boîte aux lettres
+// et joue le coup final. Rien ici n'attend le thread de recherche.
+void app::updateAI() {
+    const BoardState& state  = m_board.getState();
+    const bool        inGame = m_aiEnabled && !m_board.isGameOver();
+    const bool        aiTurn = inGame && !m_board.isPromotionPending() && state.sideToMove() == m_aiColor;
+    m_board.setInteractive(!aiTurn);
+
+    if (!aiTurn) {
+        // Tour du joueur : l'ordinateur réfléchit à sa réponse au coup qu'il attend, sur le temps de l'humain
+        const bool humanTurn = inGame && state.sideToMove() != m_aiColor;
+        if (m_ai.isPondering() && !humanTurn) {
+            m_ai.cancel();
+        } else if (m_ai.isThinking() && !m_ai.isPondering()) {
+            resetAI();
+        }
+        if (humanTurn && m_aiPonder && m_aiPonderMove && !m_ai.isThinking()) {
+            m_ai.ponder(state, m_aiPonderMove, aiLimits());
+            m_aiPonderMove = Move::none();
+        }
+        return;
+    }
+
+    // Une seule recherche par position : si le mode de jeu refuse le coup (blackout du mode bourré), on n'insiste pas
+    if ((!m_ai.isThinking() || m_ai.isPondering()) && (state.plyCount() != m_aiSearchedPly || state.key() != m_aiSearchedKey)) {
+        m_aiSearchedPly = state.plyCount();
+        m_aiSearchedKey = state.key();
+        m_aiReport      = {};
+        m_aiSearchStart = std::chrono::steady_clock::now();
+
+        // Coup attendu : la réflexion continue et devient la recherche ; sinon on repart, avec la table déjà remplie
+        if (!m_ai.ponderHit(state)) {
+            m_ai.start(state, aiLimits());
+        }
+        return;
+    }
+
+    AIReport report = m_ai.poll();
+    if (report.depth > 0 || report.finished) {
+        m_aiReport = report;
+    }
+    if (report.finished && report.bestMove) {
+        const auto elapsed = std::chrono::steady_clock::now() - m_aiSearchStart;
+        m_aiClockMs += m_aiIncrementMs - std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        m_aiPonderMove = report.ponderMove;
+        m_board.playMove(report.bestMove);
+    }
+}
+
+SearchLimits app::aiLimits() const {
+    SearchLimits limits;
+    if (m_aiUseClock) {
+        // Seule la pendule de l'ordinateur compte : le gestionnaire de temps ne regarde que le camp au trait
+        limits.timeMs[colorIndex(m_aiColor)]      = std::max<int64_t>(m_aiClockMs, 1);
+        limits.incrementMs[colorIndex(m_aiColor)] = m_aiIncrementMs;
+    } else {
+        limits.movetimeMs = m_aiMoveTimeMs;
+    }
+    limits.threads = static_cast<unsigned>(m_aiThreads);
+    return limits;
+}
+
+// Analyse continue de la position affichée : relancée dès qu'elle change, la file des itérations vidée à chaque image
+void app::updateAnalysis() {
+    if (!m_analysisEnabled || m_board.isGameOver()) {
+        m_analyzer.stop();
+        m_analysisPly = static_cast<size_t>(-1);
+        return;
+    }
+
+    const BoardState& state = m_board.getState();
+    if (state.plyCount() != m_analysisPly || state.key() != m_analysisKey) {
+        m_analysisPly = state.plyCount();
+        m_analysisKey = state.key();
+        m_analysis    = {};
+
+        SearchLimits limits;
+        limits.multiPv = m_analysisLines;
+        m_analyzer.analyze(state, limits);
+    }
+    m_analyzer.poll(m_analysis);
+}
+
+namespace {
+
+// Score du point de vue des blancs : "+0.35", ou "#3" / "#-3" pour un mat en 3 coups
+std::string formatScore(int score, PieceColor sideToMove) {
+    char text[16];
+    const int sign = (sideToMove == PieceColor::White) ? 1 : -1;
+    if (std::abs(score) >= VALUE_MATE_IN_MAX_PLY) {
+        const int moves = (VALUE_MATE - std::abs(score) + 1) / 2;
+        std::snprintf(text, sizeof(text), "#%d", score * sign > 0 ? moves : -moves);
+    } else {
+        std::snprintf(text, sizeof(text), "%+.2f", score * sign / 100.0f);
+    }
+    return text;
+}
+
+} // namespace
+
+void app::drawAnalysisWindow() {
+    if (ImGui::CollapsingHeader("Analyse")) {
+        ImGui::Checkbox("Analyser la position", &m_analysisEnabled);
+        // Changer le nombre de variantes relance l'analyse
+        if (ImGui::SliderInt("Variantes", &m_analysisLines, 1, MAX_MULTIPV)) {
+            m_analysisPly = static_cast<size_t>(-1);
+        }
+
+        if (!m_analysisEnabled || m_analysis.lineCount == 0) {
+            return;
+        }
+        ImGui::Text("Profondeur %d/%d, %llu noeuds, %.1f s", m_analysis.depth, m_analysis.selDepth,
+                    static_cast<unsigned long long>(m_analysis.nodes), m_analysis.timeMs / 1000.0);
+
+        const PieceColor sideToMove = m_board.getState().sideToMove();
+        for (int i = 0; i < m_analysis.lineCount; ++i) {
+            const PvLine& line = m_analysis.lines[i];
+            std::string   text = formatScore(line.score, sideToMove);
+            for (int ply = 0; ply < line.length; ++ply) {
+                text += ' ';
+                text += moveToUci(line.moves[ply]);
+            }
+            ImGui::TextWrapped("%d. %s", i + 1, text.c_str());
+        }
+    }
+}
+
+void app::openExplorer() {
+    // Un index construit sur une autre archive donnerait des numéros de parties qui ne correspondent à rien
+    const bool ok = m_archive.open(m_archivePath) && m_positionIndex.open(m_indexPath)
+                    && m_positionIndex.gameCount() == m_archive.gameCount();
+    m_explorerStatus = ok ? 1 : -1;
+    m_explorerKey    = 0;
+    updateExplorer();
+}
+
+// Nouvelle requête seulement quand la position change : deux recherches dichotomiques dans l'index projeté
+void app::updateExplorer() {
+    const BoardState& state = m_board.getState();
+    if (m_explorerStatus <= 0 || state.key() == m_explorerKey) {
+        return;
+    }
+    constexpr size_t MAX_GAMES = 20;
+    m_explorerKey = state.key();
+    m_explorerGameIds.resize(MAX_GAMES);
+
+    const auto start = std::chrono::steady_clock::now();
+    m_explorerGames  = m_positionIndex.games(m_explorerKey, m_explorerGameIds.data(), MAX_GAMES);
+    m_positionIndex.moves(m_explorerKey, m_explorerMoves);
+    m_explorerQueryUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    m_explorerGameIds.resize(std::min<uint64_t>(m_explorerGames, MAX_GAMES));
+    BoardState position = state;
+    m_explorerSan.clear();
+    for (const MoveStats& stats : m_explorerMoves) {
+        m_explorerSan.push_back(toSan(position, stats.move));
+    }
+}
+
+void app::drawExplorerWindow() {
+    if (ImGui::CollapsingHeader("Explorateur d'ouvertures")) {
+        ImGui::InputText("Archive", m_archivePath, sizeof(m_archivePath));
+        ImGui::InputText("Index", m_indexPath, sizeof(m_indexPath));
+        if (ImGui::Button("Ouvrir")) {
+            openExplorer();
+        }
+        if (m_explorerStatus < 0) {
+            ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "Archive ou index illisible (ou pas construits ensemble)");
+        }
+        if (m_explorerStatus <= 0) {
+            return;
+        }
+
+        updateExplorer();
+        ImGui::Text("%llu partie(s) sur %llu passent par cette position (%.1f us)", static_cast<unsigned long long>(m_explorerGames),
+                    static_cast<unsigned long long>(m_archive.gameCount()), m_explorerQueryUs);
+
+        if (!m_explorerMoves.empty() && ImGui::BeginTable("Coups", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+            ImGui::TableSetupColumn("Coup");
+            ImGui::TableSetupColumn("Parties");
+            ImGui::TableSetupColumn("Blancs");
+            ImGui::TableSetupColumn("Nulles");
+            ImGui::TableSetupColumn("Noirs");
+            ImGui::TableHeadersRow();
+            for (size_t i = 0; i < m_explorerMoves.size(); ++i) {
+                const MoveStats& stats = m_explorerMoves[i];
+                const float      total = static_cast<float>(stats.games());
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(m_explorerSan[i].c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", stats.games());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f%%", 100 * stats.results[static_cast<int>(GameResult::WhiteWins)] / total);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f%%", 100 * stats.results[static_cast<int>(GameResult::Draw)] / total);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f%%", 100 * stats.results[static_cast<int>(GameResult::BlackWins)] / total);
+            }
+            ImGui::EndTable();
+        }
+
+        for (uint32_t game : m_explorerGameIds) {
+            const std::string_view white  = m_archive.tag(game, "White");
+            const std::string_view black  = m_archive.tag(game, "Black");
+            const std::string_view result = resultToPgn(m_archive.result(game));
+            ImGui::Text("#%u  %.*s - %.*s  %.*s", game, static_cast<int>(white.size()), white.data(), static_cast<int>(black.size()),
+                        black.data(), static_cast<int>(result.size()), result.data());
+        }
+    }
+}
+
+void app::drawAIWindow() {
+    if (ImGui::CollapsingHeader("Ordinateur")) {
+        if (ImGui::Checkbox("Jouer contre l'ordinateur", &m_aiEnabled) && !m_aiEnabled) {
+            resetAI();
+        }
+
+        int  color   = (m_aiColor == PieceColor::White) ? 0 : 1;
+        bool changed = ImGui::RadioButton("Il joue les blancs", &color, 0);
+        ImGui::SameLine();
+        changed |= ImGui::RadioButton("Il joue les noirs", &color, 1);
+        if (changed) {
+            resetAI();
+            m_aiColor = (color == 0) ? PieceColor::White : PieceColor::Black;
+        }
+        ImGui::Checkbox("Pendule (base + incrément)", &m_aiUseClock);
+        if (m_aiUseClock) {
+            // Changer la cadence remet la pendule à zéro
+            bool clockChanged = ImGui::SliderInt("Base (min)", &m_aiBaseMinutes, 1, 60);
+            clockChanged |= ImGui::SliderInt("Incrément (ms)", &m_aiIncrementMs, 0, 30000);
+            if (clockChanged) {
+                m_aiClockMs = static_cast<int64_t>(m_aiBaseMinutes) * 60 * 1000;
+            }
+            ImGui::Text("Pendule de l'ordinateur : %d:%02d", static_cast<int>(m_aiClockMs / 60000),
+                        static_cast<int>(std::max<int64_t>(m_aiClockMs, 0) / 1000 % 60));
+        } else {
+            ImGui::SliderInt("Temps par coup (ms)", &m_aiMoveTimeMs, 100, 10000);
+        }
+
+        // Lazy SMP : pris en compte à la prochaine recherche
+        const int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        ImGui::SliderInt("Threads", &m_aiThreads, 1, maxThreads);
+        ImGui::Text("Recherche sur %d thread(s) (%d coeur(s) disponibles)", m_aiThreads, maxThreads);
+
+        // Taille de la table de transposition : la changer annule la recherche en cours
+        static const int hashSizes[] = {16, 64, 256, 1024, 4096};
+        if (ImGui::BeginCombo("Table (Mo)", std::to_string(m_ai.hashSize()).c_str())) {
+            for (int size : hashSizes) {
+                if (ImGui::Selectable(std::to_string(size).c_str(), m_ai.hashSize() == static_cast<size_t>(size))) {
+                    resetAI();
+                    m_ai.setHashSize(static_cast<size_t>(size));
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        // Réseau d'évaluation optionnel : sans lui, l'évaluation classique (tables pièce-case) est utilisée
+        ImGui::InputText("Réseau (NNUE)", m_aiNetworkPath, sizeof(m_aiNetworkPath));
+        if (ImGui::Button("Charger le réseau")) {
+            resetAI();
+            m_aiNetworkFailed = !m_ai.loadNetwork(m_aiNetworkPath);
+        }
+        if (m_ai.network().isLoaded()) {
+            ImGui::SameLine();
+            if (ImGui::Button("Retirer")) {
+                resetAI();
+                m_ai.unloadNetwork();
+            }
+            ImGui::Text("Évaluation : réseau %s (%s)", m_ai.network().path().c_str(), Nnue::kernelName(m_ai.network().kernel()));
+        } else {
+            ImGui::Text("Évaluation : classique");
+        }
+        if (m_aiNetworkFailed) {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Impossible de charger ce réseau");
+        }
+
+        ImGui::Checkbox("Réfléchir pendant mon tour", &m_aiPonder);
+        if (m_ai.isPondering()) {
+            ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Réflexion sur votre temps (coup attendu %s)...",
+                               moveToUci(m_ai.expectedMove()).c_str());
+        } else if (m_ai.isThinking()) {
+            ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "Réflexion...");
+        }
+        if (m_aiReport.bestMove) {
+            ImGui::Text("Profondeur %d, meilleur coup %s, score %+.2f", m_aiReport.depth,
+                        moveToUci(m_aiReport.bestMove).c_str(), m_aiReport.score / 100.0f);
+
+            const AIStats stats = m_ai.stats();
+            ImGui::Text("Noeuds: %llu, table: %.1f%% de succès, %.1f%% remplie", static_cast<unsigned long long>(stats.nodes),
+                        stats.ttHitRate * 100.0, stats.hashfull / 10.0);
+            ImGui::Text("Facteur de branchement: %.2f, coupures au 1er coup: %.0f%%", stats.branchingFactor,
+                        stats.firstMoveCutoffRate * 100.0);
+            ImGui::Text("Caches de l'évaluation: pions %.1f%%, matériel %.1f%% de succès", stats.pawnHitRate * 100.0,
+                        stats.materialHitRate * 100.0);
+        }
+    }
+}
+
 void app::drawCameraControlWindow() {
     if (ImGui::CollapsingHeader("Caméra")) {
         const char* cameraMode = (m_renderer3D.getCameraMode() == CameraMode::Trackball) ? "Mode Trackball" : "Mode Vue Pièce";
@@ -139,11 +502,16 @@ void app::drawGameOverPopup(bool& gameOverPopupClosed) {
     }
     ImGui::SetNextWindowPos(ImGui::GetMainViewport()->GetCenter(), ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
     if (ImGui::BeginPopupModal("Game Over !", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
-        PieceColor winner = m_board.getWinner();
-        const char* winnerText = (winner == PieceColor::White) ? "Blanc" : "Noir";
-        ImGui::Text("%s a gagné ! Le roi a été capturé.", winnerText);
+        if (m_board.isDraw()) {
+            ImGui::Text("Pat ! Match nul.");
+        } else {
+            PieceColor winner = m_board.getWinner();
+            const char* winnerText = (winner == PieceColor::White) ? "Blanc" : "Noir";
+            ImGui::Text("%s a gagné !", winnerText);
+        }
 
         if (ImGui::Button("Nouvelle partie", ImVec2(120, 0))) {
+            resetAI();
             m_board = Board();
             m_board.initializeBoard(&m_renderer3D);
             
@@ -169,6 +537,9 @@ void app::update() {
     lastFrameTime = currentTime;
     
     m_renderer3D.update(deltaTime);
+
+    updateAI();
+    updateAnalysis();
     
     static bool gameOverPopupClosed = false;
 
@@ -190,7 +561,7 @@ void app::update() {
         
         if (m_board.isGameOver()) {
             PieceColor winner = m_board.getWinner();
-            const char* winnerText = (winner == PieceColor::White) ? "Blanc" : "Noir";
+            const char* winnerText = m_board.isDraw() ? "aucun (pat)" : (winner == PieceColor::White) ? "Blanc" : "Noir";
             ImGui::TextColored(ImVec4(1.0f, 0.7f, 0.0f, 1.0f), "Partie terminée!");
             ImGui::Text("Vainqueur: %s", winnerText);
             ImGui::Separator();
@@ -208,6 +579,9 @@ void app::update() {
         }
         
         drawGameModeWindow();
+        drawAnalysisWindow();
+        drawExplorerWindow();
+        drawAIWindow();
         drawCameraControlWindow();
         
         ImGui::EndChild();
@@ -1,6 +1,13 @@
 #pragma once
+#include <chrono>
+#include <string>
+#include <vector>
 
 #include "Chess/Board.hpp"
+#include "Chess/AI/AIPlayer.hpp"
+#include "Chess/AI/Analysis.hpp"
+#include "Chess/Core/Archive.hpp"
+#include "Chess/Core/PositionIndex.hpp"
 #include "3Dengine/Renderer3D.hpp"
 
 class app {
@@ -11,7 +18,66 @@ public:
 private:
     Board m_board;
     Renderer3D m_renderer3D;
-    
+
+    // Adversaire ordinateur
+    AIPlayer   m_ai;
+    AIReport   m_aiReport;
+    bool       m_aiEnabled    = false;
+    PieceColor m_aiColor      = PieceColor::Black;
+    int        m_aiMoveTimeMs = 1000;
+    bool       m_aiUseClock   = false; // cadence : temps fixe par coup, ou pendule (base + incrément)
+    int        m_aiBaseMinutes = 5;
+    int        m_aiIncrementMs = 2000;
+    int64_t    m_aiClockMs     = 5 * 60 * 1000; // temps restant à la pendule de l'ordinateur
+    std::chrono::steady_clock::time_point m_aiSearchStart;
+    bool       m_aiPonder      = true;         // réflexion pendant le tour du joueur
+    Move       m_aiPonderMove  = Move::none(); // coup que l'ordinateur attend du joueur
+    int        m_aiThreads    = 1;
+    size_t     m_aiSearchedPly = static_cast<size_t>(-1); // position (nombre de coups + signature) déjà cherchée
+    uint64_t   m_aiSearchedKey = 0;
+    char       m_aiNetworkPath[256] = "";
+    bool       m_aiNetworkFailed    = false;
+
+    // Analyse continue de la position affichée
+    Analyzer   m_analyzer;
+    SearchInfo m_analysis;          // dernière itération reçue
+    bool       m_analysisEnabled = false;
+    int        m_analysisLines   = 3;
+    size_t     m_analysisPly     = static_cast<size_t>(-1); // position en cours d'analyse
+    uint64_t   m_analysisKey     = 0;
+
+    // Chargement / copie d'une position en FEN
+    char       m_fenInput[FEN_MAX_LENGTH] = "";
+    FenError   m_fenError = FenError::None;
+    char       m_pgnPath[256] = "partie.pgn";
+    int        m_pgnStatus    = 0; // 0 : rien, 1 : enregistrée, -1 : échec
+
+    void savePgn();
+
+    // Explorateur d'ouvertures : archive de parties et index des positions construits par l'outil archive
+    ArchiveReader m_archive;
+    PositionIndex m_positionIndex;
+    char          m_archivePath[256] = "parties.arc";
+    char          m_indexPath[256]   = "parties.idx";
+    int           m_explorerStatus   = 0; // 0 : rien d'ouvert, 1 : ouvert, -1 : échec
+    uint64_t      m_explorerKey      = 0; // position des résultats affichés
+    uint64_t      m_explorerGames    = 0;
+    double        m_explorerQueryUs  = 0;
+    std::vector<MoveStats>   m_explorerMoves;
+    std::vector<std::string> m_explorerSan;     // SAN de chaque coup de m_explorerMoves
+    std::vector<uint32_t>    m_explorerGameIds; // les premières parties passées par la position
+
+    void openExplorer();
+    void updateExplorer();
+    void drawExplorerWindow();
+
+    void updateAI();
+    void resetAI();
+    SearchLimits aiLimits() const; // cadence choisie dans le panneau
+    void updateAnalysis();
+    void drawAnalysisWindow();
+    void drawAIWindow();
+
     void drawGameModeWindow();
     void drawCameraControlWindow();
     void draw3DViewportWindow();
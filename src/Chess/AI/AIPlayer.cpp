@@ -0,0 +1,153 @@
+#include "AIPlayer.hpp"
+#include <algorithm>
+#include <utility>
+#include "../Core/MoveGen.hpp"
+
+// Disposition de la boîte aux lettres :
+//   bits  0-15 : coup | 16-31 : score (int16) | 32-39 : profondeur | 40 : recherche terminée | 48-63 : numéro de recherche
+uint64_t AIPlayer::pack(uint16_t generation, const AIReport& report)
+{
+    return static_cast<uint64_t>(report.bestMove.raw())
+           | static_cast<uint64_t>(static_cast<uint16_t>(static_cast<int16_t>(report.score))) << 16
+           | static_cast<uint64_t>(static_cast<uint8_t>(report.depth)) << 32
+           | static_cast<uint64_t>(report.finished) << 40
+           | static_cast<uint64_t>(generation) << 48;
+}
+
+AIReport AIPlayer::unpack(uint64_t packed)
+{
+    AIReport report;
+    report.bestMove = Move::fromRaw(static_cast<uint16_t>(packed));
+    report.score    = static_cast<int16_t>(static_cast<uint16_t>(packed >> 16));
+    report.depth    = static_cast<uint8_t>(packed >> 32);
+    report.finished = ((packed >> 40) & 1) != 0;
+    return report;
+}
+
+void AIPlayer::publish(uint16_t generation, const SearchInfo& info, bool finished)
+{
+    m_statNodes.store(info.nodes, std::memory_order_relaxed);
+    m_statProbes.store(info.ttProbes, std::memory_order_relaxed);
+    m_statHits.store(info.ttHits, std::memory_order_relaxed);
+    m_statHashfull.store(info.hashfull, std::memory_order_relaxed);
+    m_statBranching.store(info.branchingFactor, std::memory_order_relaxed);
+    m_statFirstCutoffs.store(info.firstMoveCutoffRate, std::memory_order_relaxed);
+    m_statPawnHitRate.store(info.pawnProbes ? static_cast<double>(info.pawnHits) / info.pawnProbes : 0.0, std::memory_order_relaxed);
+    m_statMaterialHitRate.store(info.materialProbes ? static_cast<double>(info.materialHits) / info.materialProbes : 0.0,
+                                std::memory_order_relaxed);
+    m_mailbox.store(pack(generation, {info.bestMove, info.score, info.depth, finished}), std::memory_order_release);
+}
+
+void AIPlayer::start(const BoardState& position, const SearchLimits& limits)
+{
+    cancel();
+
+    ++m_generation;
+    m_stop.store(false, std::memory_order_relaxed);
+    m_pondering.store(limits.ponder != nullptr, std::memory_order_relaxed);
+    m_ponderMove.store(0, std::memory_order_relaxed);
+    m_expected = Move::none();
+    m_mailbox.store(pack(m_generation, {}), std::memory_order_relaxed);
+
+    SearchLimits searchLimits = limits;
+    if (m_network.isLoaded())
+        searchLimits.network = &m_network;
+
+    m_worker = std::thread([this, position, limits = searchLimits, generation = m_generation, clear = std::exchange(m_clearPending, false)] {
+        if (clear)
+            m_tt.clear(limits.threads);
+        SearchInfo result = searchParallel(position, limits, m_tt, m_stop, [&](const SearchInfo& info) { publish(generation, info, false); });
+        m_ponderMove.store(result.ponderMove.raw(), std::memory_order_relaxed);
+        publish(generation, result, true);
+    });
+}
+
+void AIPlayer::ponder(const BoardState& position, Move expected, const SearchLimits& limits)
+{
+    // Le coup attendu vient d'une recherche sur une autre position : si le mode de jeu a changé la donne, on ne devine rien
+    MoveList moves;
+    generateLegalMoves(position, moves);
+    if (std::find(moves.begin(), moves.end(), expected) == moves.end())
+        return;
+
+    BoardState afterExpected = position;
+    afterExpected.makeMove(expected);
+
+    SearchLimits ponderLimits = limits;
+    ponderLimits.ponder       = &m_pondering;
+    start(afterExpected, ponderLimits);
+
+    m_expected  = expected;
+    m_ponderKey = afterExpected.key();
+}
+
+bool AIPlayer::ponderHit(const BoardState& position)
+{
+    if (!isPondering() || position.key() != m_ponderKey)
+        return false;
+
+    m_pondering.store(false, std::memory_order_release);
+    return true;
+}
+
+bool AIPlayer::loadNetwork(const std::string& path)
+{
+    cancel();
+    return m_network.load(path);
+}
+
+void AIPlayer::unloadNetwork()
+{
+    cancel();
+    m_network.unload();
+}
+
+void AIPlayer::cancel()
+{
+    if (!m_worker.joinable())
+        return;
+
+    m_stop.store(true, std::memory_order_relaxed);
+    m_worker.join();
+    m_mailbox.store(0, std::memory_order_relaxed);
+}
+
+AIReport AIPlayer::poll()
+{
+    const uint64_t packed = m_mailbox.load(std::memory_order_acquire);
+    if ((packed >> 48) != m_generation || m_pondering.load(std::memory_order_relaxed))
+        return {};
+
+    AIReport report = unpack(packed);
+    // Le thread a fini son travail : on le rattache tout de suite (il ne reste que le retour de la lambda)
+    // et on vide la boîte, pour que le coup final ne soit remis qu'une seule fois
+    if (report.finished)
+    {
+        report.ponderMove = Move::fromRaw(m_ponderMove.load(std::memory_order_relaxed));
+        if (m_worker.joinable())
+            m_worker.join();
+        m_mailbox.store(0, std::memory_order_relaxed);
+    }
+    return report;
+}
+
+void AIPlayer::setHashSize(size_t megabytes)
+{
+    cancel();
+    m_tt.resize(megabytes);
+    m_clearPending = false; // table neuve : rien à effacer
+}
+
+AIStats AIPlayer::stats() const
+{
+    AIStats        stats;
+    const uint64_t probes     = m_statProbes.load(std::memory_order_relaxed);
+    stats.nodes               = m_statNodes.load(std::memory_order_relaxed);
+    stats.ttHitRate           = probes ? static_cast<double>(m_statHits.load(std::memory_order_relaxed)) / probes : 0.0;
+    stats.hashfull            = m_statHashfull.load(std::memory_order_relaxed);
+    stats.branchingFactor     = m_statBranching.load(std::memory_order_relaxed);
+    stats.firstMoveCutoffRate = m_statFirstCutoffs.load(std::memory_order_relaxed);
+    stats.pawnHitRate         = m_statPawnHitRate.load(std::memory_order_relaxed);
+    stats.materialHitRate     = m_statMaterialHitRate.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "../Core/BoardState.hpp"
+#include "../Core/Move.hpp"
+#include "Endgames.hpp"
+#include "Nnue.hpp"
+#include "Search.hpp"
+#include "TranspositionTable.hpp"
+
+// Ce que la recherche a trouvé jusqu'ici, tel que lu par l'interface
+struct AIReport {
+    Move bestMove = Move::none();
+    int  score    = 0;
+    int  depth    = 0;
+    bool finished = false; // la recherche est terminée : bestMove est le coup à jouer
+    Move ponderMove = Move::none(); // avec finished : la réponse que la recherche attend de l'adversaire
+};
+
+// Statistiques de la dernière itération, pour l'affichage (hors boîte aux lettres : elles n'ont pas à être cohérentes avec le coup)
+struct AIStats {
+    uint64_t nodes               = 0;
+    double   ttHitRate           = 0.0; // part des consultations de la table qui ont trouvé la position
+    int      hashfull            = 0;   // pour mille
+    double   branchingFactor     = 0.0;
+    double   firstMoveCutoffRate = 0.0;
+    double   pawnHitRate         = 0.0; // caches de l'évaluation
+    double   materialHitRate     = 0.0;
+};
+
+/**
+ * @brief Adversaire ordinateur : la recherche tourne sur un thread à part.
+ *
+ * Le thread de recherche dépose son meilleur coup courant dans une "boîte aux lettres" : un seul atomique 64 bits
+ * (coup, score, profondeur, fin, numéro de recherche). L'interface la relève à chaque image avec poll(),
+ * sans verrou ni attente, et la boucle d'affichage garde donc sa cadence pendant toute la réflexion.
+ */
+class AIPlayer {
+public:
+    AIPlayer() { Endgames::init(); }
+    ~AIPlayer() { cancel(); }
+
+    AIPlayer(const AIPlayer&)            = delete;
+    AIPlayer& operator=(const AIPlayer&) = delete;
+
+    // Lance une recherche sur une copie de la position (annule la précédente s'il y en a une)
+    void start(const BoardState& position, const SearchLimits& limits);
+
+    // Arrête la recherche en cours : le thread voit le drapeau en quelques milliers de noeuds au plus
+    void cancel();
+
+    bool isThinking() const { return m_worker.joinable(); }
+
+    // Réflexion sur le temps de l'adversaire : cherche la position après le coup qu'on attend de lui, sans limite de temps.
+    // Rien n'est rendu par poll() tant que ponderHit() n'a pas confirmé le coup.
+    void ponder(const BoardState& position, Move expected, const SearchLimits& limits);
+    bool isPondering() const { return isThinking() && m_pondering.load(std::memory_order_relaxed); }
+    Move expectedMove() const { return m_expected; }
+
+    // L'adversaire a joué : si c'est le coup attendu, la réflexion en cours devient la vraie recherche (true).
+    // Sinon il faut relancer avec start() : la table garde tout ce que la réflexion y a mis.
+    bool ponderHit(const BoardState& position);
+
+    // Nouvelle partie : on oublie ce que la table a appris (à n'appeler qu'hors recherche, après cancel()).
+    // L'effacement est fait par le thread de la prochaine recherche, partagé entre ses threads : l'interface n'attend pas
+    void newGame() { m_clearPending = true; }
+
+    // Taille de la table de transposition en Mo (annule la recherche en cours)
+    void   setHashSize(size_t megabytes);
+    size_t hashSize() const { return m_tt.sizeMegabytes(); }
+
+    // Évaluation par réseau de neurones : utilisée par les recherches suivantes tant qu'un réseau est chargé
+    // (annule la recherche en cours ; en cas d'échec, on revient à l'évaluation classique)
+    bool                 loadNetwork(const std::string& path);
+    void                 unloadNetwork();
+    const Nnue::Network& network() const { return m_network; }
+
+    AIStats stats() const;
+
+    // Dernier rapport de la recherche en cours (vide si aucune recherche n'a encore rien publié).
+    // Le rapport final (finished) n'est rendu qu'une fois.
+    AIReport poll();
+
+private:
+    void publish(uint16_t generation, const SearchInfo& info, bool finished);
+
+    static uint64_t pack(uint16_t generation, const AIReport& report);
+    static AIReport unpack(uint64_t packed);
+
+    TranspositionTable    m_tt{64}; // partagée par les threads d'une recherche, conservée d'un coup à l'autre
+    Nnue::Network         m_network;
+    std::thread           m_worker;
+    std::atomic<bool>     m_stop{false};
+    std::atomic<bool>     m_pondering{false};
+    std::atomic<uint16_t> m_ponderMove{0}; // réponse attendue, écrite avant le rapport final
+    bool                  m_clearPending = false;        // newGame() : table à effacer avant la prochaine recherche
+    Move                  m_expected     = Move::none(); // coup adverse sur lequel porte la réflexion
+    uint64_t              m_ponderKey    = 0;            // position après ce coup
+    std::atomic<uint64_t> m_mailbox{0};
+    std::atomic<uint64_t> m_statNodes{0};
+    std::atomic<uint64_t> m_statProbes{0};
+    std::atomic<uint64_t> m_statHits{0};
+    std::atomic<int>      m_statHashfull{0};
+    std::atomic<double>   m_statBranching{0.0};
+    std::atomic<double>   m_statFirstCutoffs{0.0};
+    std::atomic<double>   m_statPawnHitRate{0.0};
+    std::atomic<double>   m_statMaterialHitRate{0.0};
+    uint16_t              m_generation = 0; // numéro de la recherche en cours : un rapport d'une recherche annulée est ignoré
+};
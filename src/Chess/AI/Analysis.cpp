@@ -0,0 +1,43 @@
+#include "Analysis.hpp"
+
+void Analyzer::analyze(const BoardState& position, const SearchLimits& limits)
+{
+    stop();
+
+    SearchLimits analysisLimits = limits;
+    analysisLimits.depth        = MAX_PLY - 1;
+    analysisLimits.movetimeMs   = 0;
+    analysisLimits.nodes        = 0;
+    analysisLimits.timeMs[0]    = 0;
+    analysisLimits.timeMs[1]    = 0;
+    analysisLimits.ponder       = nullptr;
+
+    m_stop.store(false, std::memory_order_relaxed);
+    m_worker = std::thread([this, position, analysisLimits] {
+        // File pleine : l'itération est perdue, la suivante la remplacera de toute façon
+        searchParallel(position, analysisLimits, m_tt, m_stop, [this](const SearchInfo& info) { m_updates.push(info); });
+    });
+}
+
+void Analyzer::stop()
+{
+    if (!m_worker.joinable())
+        return;
+
+    m_stop.store(true, std::memory_order_relaxed);
+    m_worker.join();
+
+    // Les itérations de l'ancienne position ne doivent pas s'afficher sur la nouvelle
+    SearchInfo discarded;
+    while (m_updates.pop(discarded))
+    {
+    }
+}
+
+bool Analyzer::poll(SearchInfo& latest)
+{
+    bool received = false;
+    while (m_updates.pop(latest))
+        received = true;
+    return received;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include "../Core/BoardState.hpp"
+#include "Search.hpp"
+#include "SpscQueue.hpp"
+#include "TranspositionTable.hpp"
+
+/**
+ * @brief Analyse continue d'une position : les N meilleures variantes, sans limite de temps.
+ *
+ * Le thread d'analyse pousse chaque itération terminée dans une file SPSC ; l'interface la vide à chaque image
+ * avec poll(), sans verrou. Changer de position arrête la recherche en cours (elle relit le drapeau d'arrêt
+ * toutes les demi-millisecondes environ) et en relance une ; la table, elle, est gardée d'une position à l'autre.
+ */
+class Analyzer {
+public:
+    explicit Analyzer(size_t hashMegabytes = 32) : m_tt(hashMegabytes) {}
+    ~Analyzer() { stop(); }
+
+    Analyzer(const Analyzer&)            = delete;
+    Analyzer& operator=(const Analyzer&) = delete;
+
+    // (Re)lance l'analyse de position ; limits.multiPv variantes, sans limite de temps ni de noeuds
+    void analyze(const BoardState& position, const SearchLimits& limits);
+    void stop();
+
+    bool isRunning() const { return m_worker.joinable(); }
+
+    // Côté interface : vide la file et garde la dernière itération reçue ; false si rien de neuf
+    bool poll(SearchInfo& latest);
+
+private:
+    TranspositionTable        m_tt; // à elle seule : l'analyse peut tourner pendant que l'ordinateur joue
+    std::thread               m_worker;
+    std::atomic<bool>         m_stop{false};
+    SpscQueue<SearchInfo, 64> m_updates;
+};
@@ -0,0 +1,205 @@
+#include "Endgames.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "Evaluation.hpp"
+
+namespace Endgames {
+
+namespace {
+
+int distance(int a, int b)
+{
+    return std::max(std::abs(fileOf(a) - fileOf(b)), std::abs(rankOf(a) - rankOf(b)));
+}
+
+// 0 au centre, 6 dans un coin : le roi faible doit être repoussé vers le bord
+int edgeDistance(int sq)
+{
+    const int file = fileOf(sq);
+    const int rank = rankOf(sq);
+    return std::max(3 - file, file - 4) + std::max(3 - rank, rank - 4);
+}
+
+// --- Table de roi + pion contre roi ---
+// Le camp fort est ramené aux blancs, le pion aux colonnes a à d. Index : roi blanc | roi noir << 6 | trait << 12
+// | colonne du pion << 13 | (rangée du pion - 1) << 15, soit 2 x 24 x 64 x 64 positions.
+constexpr int KPK_SIZE = 2 * 24 * 64 * 64;
+
+enum KpkResult : uint8_t {
+    Invalid = 0,
+    Unknown = 1,
+    Draw    = 2,
+    Win     = 4,
+};
+
+int kpkIndex(int side, int whiteKing, int blackKing, int pawn)
+{
+    return whiteKing | (blackKing << 6) | (side << 12) | (fileOf(pawn) << 13) | ((rankOf(pawn) - 1) << 15);
+}
+
+// Classement initial : positions illégales, promotions sûres, pats et pions perdus
+KpkResult kpkInitial(int index)
+{
+    const int whiteKing = index & 63;
+    const int blackKing = (index >> 6) & 63;
+    const int side      = (index >> 12) & 1;
+    const int pawn      = makeSquare((index >> 13) & 3, ((index >> 15) & 7) + 1);
+
+    if (distance(whiteKing, blackKing) <= 1 || whiteKing == pawn || blackKing == pawn
+        || (side == 0 && (Attacks::pawn(PieceColor::White, pawn) & squareBB(blackKing))))
+        return Invalid;
+
+    // Blancs au trait, pion en 7e : il passe si la case de promotion est libre et ne peut pas être reprise
+    if (side == 0 && rankOf(pawn) == 6 && whiteKing != pawn + 8 && blackKing != pawn + 8
+        && (distance(blackKing, pawn + 8) > 1 || distance(whiteKing, pawn + 8) == 1))
+        return Win;
+
+    // Noirs au trait : pat, ou prise du pion non défendu
+    if (side == 1)
+    {
+        const Bitboard kingMoves = Attacks::king(blackKing);
+        const Bitboard guarded   = Attacks::king(whiteKing) | Attacks::pawn(PieceColor::White, pawn);
+        if (!(kingMoves & ~guarded) || (kingMoves & ~Attacks::king(whiteKing) & squareBB(pawn)))
+            return Draw;
+    }
+    return Unknown;
+}
+
+// Analyse rétrograde : on propage les résultats connus jusqu'à ce que plus rien ne change
+std::vector<uint8_t> buildKpk()
+{
+    std::vector<uint8_t> table(KPK_SIZE);
+    for (int index = 0; index < KPK_SIZE; ++index)
+        table[index] = kpkInitial(index);
+
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int index = 0; index < KPK_SIZE; ++index)
+        {
+            if (table[index] != Unknown)
+                continue;
+
+            const int whiteKing = index & 63;
+            const int blackKing = (index >> 6) & 63;
+            const int side      = (index >> 12) & 1;
+            const int pawn      = makeSquare((index >> 13) & 3, ((index >> 15) & 7) + 1);
+
+            // Résultats (en OU de bits) des positions atteignables ; les coups illégaux donnent Invalid
+            int      results = Invalid;
+            Bitboard moves   = Attacks::king(side == 0 ? whiteKing : blackKing);
+            while (moves)
+            {
+                const int to = popLsb(moves);
+                results |= side == 0 ? table[kpkIndex(1, to, blackKing, pawn)] : table[kpkIndex(0, whiteKing, to, pawn)];
+            }
+            if (side == 0 && rankOf(pawn) < 6 && pawn + 8 != whiteKing && pawn + 8 != blackKing)
+            {
+                results |= table[kpkIndex(1, whiteKing, blackKing, pawn + 8)];
+                if (rankOf(pawn) == 1 && pawn + 16 != whiteKing && pawn + 16 != blackKing)
+                    results |= table[kpkIndex(1, whiteKing, blackKing, pawn + 16)];
+            }
+
+            // Les blancs cherchent un coup gagnant, les noirs un coup qui annule
+            const uint8_t result = side == 0 ? (results & Win ? Win : results & Unknown ? Unknown : Draw)
+                                             : (results & Draw ? Draw : results & Unknown ? Unknown : Win);
+            if (result != Unknown)
+            {
+                table[index] = result;
+                changed      = true;
+            }
+        }
+    }
+    return table;
+}
+
+const std::vector<uint8_t>& kpkTable()
+{
+    static const std::vector<uint8_t> table = buildKpk();
+    return table;
+}
+
+} // namespace
+
+void init()
+{
+    kpkTable();
+}
+
+bool kpkIsWin(PieceColor strong, int strongKing, int weakKing, int pawn, PieceColor sideToMove)
+{
+    const std::vector<uint8_t>& table = kpkTable();
+
+    // Camp fort ramené aux blancs, pion ramené sur l'aile dame
+    if (strong == PieceColor::Black)
+    {
+        strongKing ^= 56;
+        weakKing ^= 56;
+        pawn ^= 56;
+    }
+    if (fileOf(pawn) >= 4)
+    {
+        strongKing ^= 7;
+        weakKing ^= 7;
+        pawn ^= 7;
+    }
+    const int side = sideToMove == strong ? 0 : 1;
+    return table[kpkIndex(side, strongKing, weakKing, pawn)] == Win;
+}
+
+int kxk(const BoardState& board, PieceColor strong)
+{
+    const int strongKing = board.kingSquare(strong);
+    const int weakKing   = board.kingSquare(~strong);
+
+    int material = 0;
+    for (PieceType type : {PieceType::Pawn, PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen})
+        material += pieceValue(type) * popCount(board.pieces(strong, type));
+
+    // Roi faible au bord, rois proches : c'est comme ça qu'on mate
+    return VALUE_KNOWN_WIN + material + 20 * edgeDistance(weakKing) + 10 * (7 - distance(strongKing, weakKing));
+}
+
+int kbnk(const BoardState& board, PieceColor strong)
+{
+    const int strongKing = board.kingSquare(strong);
+    int       weakKing   = board.kingSquare(~strong);
+    const int bishop     = lsb(board.pieces(strong, PieceType::Bishop));
+
+    // Seuls les coins de la couleur du fou permettent le mat : on se ramène à a1 / h8 (cases noires)
+    const bool darkBishop = ((fileOf(bishop) + rankOf(bishop)) & 1) == 0;
+    if (!darkBishop)
+        weakKing ^= 7; // miroir : les coins a8 / h1 deviennent a1 / h8
+
+    const int cornerDistance = std::min(distance(weakKing, 0), distance(weakKing, 63));
+    return VALUE_KNOWN_WIN + pieceValue(PieceType::Bishop) + pieceValue(PieceType::Knight) + 40 * (7 - cornerDistance)
+           + 10 * (7 - distance(strongKing, board.kingSquare(~strong)));
+}
+
+int kbbk(const BoardState& board, PieceColor strong)
+{
+    // Des fous tous de la même couleur ne contrôlent jamais les cases de l'autre : le roi y reste à l'abri
+    const Bitboard bishops = board.pieces(strong, PieceType::Bishop);
+    if ((bishops & DARK_SQUARES_BB) && (bishops & LIGHT_SQUARES_BB))
+        return kxk(board, strong);
+    return draw(board, strong);
+}
+
+int kpk(const BoardState& board, PieceColor strong)
+{
+    const int pawn = lsb(board.pieces(strong, PieceType::Pawn));
+    if (!kpkIsWin(strong, board.kingSquare(strong), board.kingSquare(~strong), pawn, board.sideToMove()))
+        return 0;
+
+    const int advance = strong == PieceColor::White ? rankOf(pawn) : 7 - rankOf(pawn);
+    return VALUE_KNOWN_WIN + pieceValue(PieceType::Pawn) + 10 * advance;
+}
+
+int draw(const BoardState&, PieceColor)
+{
+    return 0;
+}
+
+} // namespace Endgames
@@ -0,0 +1,26 @@
+#pragma once
+#include "../Core/BoardState.hpp"
+
+// Finales connues, évaluées par des règles plutôt que par les tables : le matériel seul ne dit pas
+// comment mater avec fou et cavalier, ni si un pion seul passe.
+namespace Endgames {
+
+// Score "gagné à coup sûr" : au-dessus de toute évaluation normale, mais sous les scores de mat
+constexpr int VALUE_KNOWN_WIN = 10000;
+
+// Évaluation spécialisée, du point de vue du camp fort
+using Function = int (*)(const BoardState& board, PieceColor strong);
+
+int kxk(const BoardState& board, PieceColor strong);  // assez de matériel contre un roi seul (KRK, KQK...)
+int kbnk(const BoardState& board, PieceColor strong); // fou + cavalier : mat dans le coin de la couleur du fou
+int kbbk(const BoardState& board, PieceColor strong); // fous seuls : gagné s'il y en a sur les deux couleurs, nulle sinon
+int kpk(const BoardState& board, PieceColor strong);  // roi + pion contre roi : table exacte
+int draw(const BoardState& board, PieceColor strong); // matériel insuffisant (KK, KNK, KBK, KNNK)
+
+// Calcule la table KPK d'avance (quelques dizaines de ms) : sinon elle l'est au premier appel, en pleine recherche
+void init();
+
+// Résultat exact de roi + pion contre roi
+bool kpkIsWin(PieceColor strong, int strongKing, int weakKing, int pawn, PieceColor sideToMove);
+
+} // namespace Endgames
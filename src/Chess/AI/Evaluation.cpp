@@ -0,0 +1,29 @@
+#include "Evaluation.hpp"
+#include <algorithm>
+
+namespace {
+
+// Petit bonus au camp qui a le trait
+constexpr int TEMPO = 10;
+
+} // namespace
+
+// Évaluation "effilée" : les scores de milieu et de fin de partie, tenus à jour par BoardState ou pris dans les caches,
+// sont mélangés selon le matériel restant. Aucune boucle sur l'échiquier tant que les pions ne bougent pas.
+int evaluate(const BoardState& board, EvalTables& tables)
+{
+    const MaterialTable::Entry& material = tables.material.probe(board);
+    if (material.endgame)
+    {
+        const int score = material.endgame(board, material.strong);
+        return board.sideToMove() == material.strong ? score : -score;
+    }
+
+    Psqt::Score psqt = board.psqt();
+    psqt += material.imbalance;
+    psqt += tables.pawns.probe(board).score;
+
+    const int phase = std::min(board.phase(), Psqt::PHASE_MAX); // les promotions peuvent dépasser le maximum
+    const int score = (psqt.mg * phase + psqt.eg * (Psqt::PHASE_MAX - phase)) / Psqt::PHASE_MAX;
+    return (board.sideToMove() == PieceColor::White ? score : -score) + TEMPO;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <array>
+#include "../Core/BoardState.hpp"
+#include "Material.hpp"
+#include "Pawns.hpp"
+
+// Valeurs en centipions, indexées par typeIndex (Pion, Tour, Cavalier, Fou, Dame, Roi).
+// Elles servent aux échanges (SEE, élagage delta) ; l'évaluation, elle, utilise les tables de Psqt.hpp
+inline constexpr std::array<int, 6> PIECE_VALUES = {100, 500, 320, 330, 900, 0};
+
+inline int pieceValue(PieceType type) { return type == PieceType::None ? 0 : PIECE_VALUES[typeIndex(type)]; }
+
+// Caches de l'évaluation : un jeu par thread de recherche, sans partage
+struct EvalTables {
+    PawnTable     pawns;
+    MaterialTable material;
+};
+
+// Évaluation statique du point de vue du camp qui a le trait (positif = bon pour lui) :
+// matériel, tables pièce-case, déséquilibres et structure de pions, interpolés entre milieu et fin de partie
+// selon la phase. Les finales connues (KBNK, KRK, KPK...) ont leur propre évaluation.
+int evaluate(const BoardState& board, EvalTables& tables);
@@ -0,0 +1,113 @@
+#include "Material.hpp"
+
+namespace {
+
+constexpr Psqt::Score BISHOP_PAIR = {30, 50};
+// Par pion au-dessus (ou en dessous) de 5 : les cavaliers aiment les positions fermées, les tours les ouvertes
+constexpr Psqt::Score KNIGHT_PAWN_ADJUST = {4, 4};
+constexpr Psqt::Score ROOK_PAWN_ADJUST   = {-8, -8};
+
+// Nombre de pièces d'une sorte, relu directement dans la signature
+int count(uint64_t key, PieceColor color, PieceType type)
+{
+    return static_cast<int>((key / BoardState::materialUnit(color, type)) & 15);
+}
+
+Psqt::Score scaled(Psqt::Score score, int factor)
+{
+    return {score.mg * factor, score.eg * factor};
+}
+
+Psqt::Score imbalance(uint64_t key, PieceColor color)
+{
+    const int   pawns = count(key, color, PieceType::Pawn);
+    Psqt::Score score;
+    if (count(key, color, PieceType::Bishop) >= 2)
+        score += BISHOP_PAIR;
+    score += scaled(KNIGHT_PAWN_ADJUST, count(key, color, PieceType::Knight) * (pawns - 5));
+    score += scaled(ROOK_PAWN_ADJUST, count(key, color, PieceType::Rook) * (pawns - 5));
+    return score;
+}
+
+bool onlyKing(uint64_t key, PieceColor color)
+{
+    for (PieceType type : {PieceType::Pawn, PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen})
+    {
+        if (count(key, color, type))
+            return false;
+    }
+    return true;
+}
+
+// Finale connue du point de vue de strong contre un roi seul, ou nullptr
+Endgames::Function loneKingEndgame(uint64_t key, PieceColor strong)
+{
+    const int pawns   = count(key, strong, PieceType::Pawn);
+    const int knights = count(key, strong, PieceType::Knight);
+    const int bishops = count(key, strong, PieceType::Bishop);
+    const int rooks   = count(key, strong, PieceType::Rook);
+    const int queens  = count(key, strong, PieceType::Queen);
+
+    if (pawns == 0 && knights == 1 && bishops == 1 && rooks == 0 && queens == 0)
+        return Endgames::kbnk;
+    if (pawns == 1 && knights + bishops + rooks + queens == 0)
+        return Endgames::kpk;
+    if (pawns == 0 && knights == 0 && rooks + queens == 0 && bishops >= 2)
+        return Endgames::kbbk; // la couleur des fous n'est pas dans la signature : kbbk la regarde sur l'échiquier
+    if (queens > 0 || rooks > 0 || bishops >= 2)
+        return Endgames::kxk;
+    if (pawns == 0 && rooks + queens == 0 && bishops + knights <= 1)
+        return Endgames::draw;
+    if (pawns == 0 && bishops == 0 && knights == 2)
+        return Endgames::draw; // KNNK : pas de mat forcé
+    return nullptr;
+}
+
+void increment(std::atomic<uint64_t>& counter)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+const MaterialTable::Entry& MaterialTable::probe(const BoardState& board)
+{
+    const uint64_t key   = board.materialKey();
+    Entry&         entry = m_entries[(key * 0x9E3779B97F4A7C15ULL >> 32) & (m_entries.size() - 1)];
+    increment(m_probes);
+    if (entry.key == key)
+    {
+        increment(m_hits);
+        return entry;
+    }
+
+    entry           = Entry{};
+    entry.key       = key;
+    entry.imbalance = imbalance(key, PieceColor::White);
+    entry.imbalance -= imbalance(key, PieceColor::Black);
+
+    for (PieceColor strong : {PieceColor::White, PieceColor::Black})
+    {
+        if (onlyKing(key, ~strong))
+        {
+            entry.endgame = loneKingEndgame(key, strong);
+            entry.strong  = strong;
+            break;
+        }
+    }
+
+    // Fou ou cavalier seul de chaque côté : nulle
+    if (!entry.endgame && count(key, PieceColor::White, PieceType::Pawn) + count(key, PieceColor::Black, PieceType::Pawn) == 0)
+    {
+        bool insufficient = true;
+        for (PieceColor color : {PieceColor::White, PieceColor::Black})
+        {
+            if (count(key, color, PieceType::Rook) + count(key, color, PieceType::Queen) > 0
+                || count(key, color, PieceType::Knight) + count(key, color, PieceType::Bishop) > 1)
+                insufficient = false;
+        }
+        if (insufficient)
+            entry.endgame = Endgames::draw;
+    }
+    return entry;
+}
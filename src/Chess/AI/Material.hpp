@@ -0,0 +1,34 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include "../Core/BoardState.hpp"
+#include "Endgames.hpp"
+
+// Ce que le matériel seul permet de dire (déséquilibres, finale connue), mis en cache par signature du matériel :
+// elle ne change qu'aux prises et aux promotions.
+class MaterialTable {
+public:
+    struct Entry {
+        uint64_t           key = 0;
+        Psqt::Score        imbalance;         // positif = bon pour les blancs
+        Endgames::Function endgame = nullptr; // finale connue : elle remplace toute l'évaluation
+        PieceColor         strong  = PieceColor::White;
+    };
+
+    explicit MaterialTable(size_t entries = 8192) : m_entries(std::bit_floor(std::max<size_t>(entries, 1))) {}
+
+    // Entrée de la position, calculée si elle n'était pas en cache
+    const Entry& probe(const BoardState& board);
+
+    // Lus par les autres threads pour les statistiques
+    uint64_t probes() const { return m_probes.load(std::memory_order_relaxed); }
+    uint64_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<Entry>    m_entries; // taille puissance de 2
+    std::atomic<uint64_t> m_probes{0};
+    std::atomic<uint64_t> m_hits{0};
+};
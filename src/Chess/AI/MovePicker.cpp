@@ -0,0 +1,183 @@
+#include "MovePicker.hpp"
+#include <algorithm>
+#include "../Core/MoveGen.hpp"
+#include "Evaluation.hpp"
+#include "See.hpp"
+
+void HistoryTables::clear()
+{
+    for (auto& color : butterfly)
+        for (auto& from : color)
+            from.fill(0);
+    for (auto& piece : continuation)
+        for (auto& to : piece)
+            for (auto& history : to)
+                history.fill(0);
+    for (auto& piece : counterMoves)
+        piece.fill(Move::none());
+}
+
+MovePicker::MovePicker(const BoardState& board, Move ttMove, const Move* killers, Move counterMove, const HistoryTables& history,
+                       const PieceToHistory* const* continuation)
+    : m_board(board), m_history(history), m_continuation(continuation), m_ttMove(ttMove), m_killers{killers[0], killers[1]},
+      m_counterMove(counterMove)
+{
+    // Le coup de la table peut venir d'une collision de signatures : on vérifie qu'il est jouable
+    m_stage = (m_ttMove && isLegal(board, m_ttMove)) ? Stage::TTMove : Stage::GenerateCaptures;
+    if (m_stage != Stage::TTMove)
+        m_ttMove = Move::none();
+}
+
+MovePicker::MovePicker(const BoardState& board, Move ttMove, const HistoryTables& history)
+    : m_board(board), m_history(history), m_continuation(nullptr), m_ttMove(ttMove), m_killers{Move::none(), Move::none()},
+      m_counterMove(Move::none())
+{
+    // Hors échec, seules les prises et promotions sont cherchées au repos
+    m_quiescence = !board.inCheck();
+    if (m_quiescence && !ttMove.isCapture() && !ttMove.isPromotion())
+        m_ttMove = Move::none();
+
+    m_stage = (m_ttMove && isLegal(board, m_ttMove)) ? Stage::TTMove : Stage::GenerateCaptures;
+    if (m_stage != Stage::TTMove)
+        m_ttMove = Move::none();
+}
+
+// Tueurs et contre-coup viennent d'autres positions : ils doivent être calmes ici, et légaux
+bool MovePicker::isQuietCandidate(Move move) const
+{
+    return move && move != m_ttMove && !move.isCapture() && !move.isPromotion() && isLegal(m_board, move);
+}
+
+// MVV-LVA : la victime la plus chère d'abord, et à victime égale l'attaquant le moins cher
+void MovePicker::scoreCaptures()
+{
+    m_count = 0;
+    for (Move move : m_moves)
+    {
+        if (move == m_ttMove)
+            continue;
+
+        const PieceType victim   = move.isEnPassant() ? PieceType::Pawn : m_board.typeAt(move.to());
+        const PieceType attacker = m_board.typeAt(move.from());
+        int             score    = 16 * pieceValue(victim) - pieceValue(attacker) / 10;
+        if (move.isPromotion())
+            score += 16 * (pieceValue(move.promotionType()) - pieceValue(PieceType::Pawn));
+        m_scored[m_count++] = {move, score};
+    }
+}
+
+void MovePicker::scoreQuiets()
+{
+    const PieceColor us = m_board.sideToMove();
+    m_count             = 0;
+    for (Move move : m_moves)
+    {
+        if (isSpecial(move))
+            continue;
+
+        const int piece = pieceIndex(us, m_board.typeAt(move.from()));
+        const int to    = move.to();
+        int       score = m_history.butterfly[colorIndex(us)][move.from()][to];
+        for (int i = 0; m_continuation && i < 2; ++i)
+        {
+            if (m_continuation[i])
+                score += (*m_continuation[i])[piece][to];
+        }
+        m_scored[m_count++] = {move, score};
+    }
+
+    // Tri par insertion décroissant : quelques dizaines de coups, déjà à moitié rangés en pratique
+    for (size_t i = 1; i < m_count; ++i)
+    {
+        ScoredMove moving = m_scored[i];
+        size_t     j      = i;
+        for (; j > 0 && m_scored[j - 1].score < moving.score; --j)
+            m_scored[j] = m_scored[j - 1];
+        m_scored[j] = moving;
+    }
+}
+
+Move MovePicker::next()
+{
+    switch (m_stage)
+    {
+    case Stage::TTMove:
+        m_stage = Stage::GenerateCaptures;
+        return m_ttMove;
+
+    case Stage::GenerateCaptures:
+        generateLegalMoves(m_board, m_moves, GenType::Captures);
+        scoreCaptures();
+        m_badCaptures.clear();
+        m_current = 0;
+        m_stage   = Stage::Captures;
+        [[fallthrough]];
+
+    case Stage::Captures:
+        // Sélection du meilleur restant : on s'arrête souvent après la première prise.
+        // Le SEE n'est calculé que pour les prises effectivement atteintes.
+        while (m_current < m_count)
+        {
+            auto best = std::max_element(m_scored.begin() + m_current, m_scored.begin() + m_count,
+                                         [](const ScoredMove& a, const ScoredMove& b) { return a.score < b.score; });
+            std::iter_swap(m_scored.begin() + m_current, best);
+            const Move move = m_scored[m_current++].move;
+            if (seeGE(m_board, move, 0))
+                return move;
+            if (!m_quiescence)
+                m_badCaptures.push(move);
+        }
+        if (m_quiescence)
+        {
+            m_stage = Stage::Done;
+            return Move::none();
+        }
+        m_stage = Stage::Killer1;
+        [[fallthrough]];
+
+    case Stage::Killer1:
+        m_stage = Stage::Killer2;
+        if (isQuietCandidate(m_killers[0]))
+            return m_killers[0];
+        m_killers[0] = Move::none();
+        [[fallthrough]];
+
+    case Stage::Killer2:
+        m_stage = Stage::CounterMove;
+        if (m_killers[1] != m_killers[0] && isQuietCandidate(m_killers[1]))
+            return m_killers[1];
+        m_killers[1] = Move::none();
+        [[fallthrough]];
+
+    case Stage::CounterMove:
+        m_stage = Stage::GenerateQuiets;
+        if (m_counterMove != m_killers[0] && m_counterMove != m_killers[1] && isQuietCandidate(m_counterMove))
+            return m_counterMove;
+        m_counterMove = Move::none();
+        [[fallthrough]];
+
+    case Stage::GenerateQuiets:
+        generateLegalMoves(m_board, m_moves, GenType::Quiets);
+        scoreQuiets();
+        m_current = 0;
+        m_stage   = Stage::Quiets;
+        [[fallthrough]];
+
+    case Stage::Quiets:
+        if (m_current < m_count)
+            return m_scored[m_current++].move;
+        m_current = 0;
+        m_stage   = Stage::BadCaptures;
+        [[fallthrough]];
+
+    case Stage::BadCaptures:
+        if (m_current < m_badCaptures.size())
+            return m_badCaptures[m_current++];
+        m_stage = Stage::Done;
+        [[fallthrough]];
+
+    case Stage::Done:
+        break;
+    }
+    return Move::none();
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include "../Core/BoardState.hpp"
+#include "../Core/Move.hpp"
+
+// Index d'une pièce (couleur + type) dans les tables d'historique : 0..11
+inline int pieceIndex(PieceColor color, PieceType type) { return colorIndex(color) * 6 + typeIndex(type); }
+
+constexpr int HISTORY_MAX = 16384;
+
+// Mise à jour "avec gravité" : la valeur tend vers +-HISTORY_MAX sans jamais le dépasser,
+// et un bonus récent pèse plus lourd qu'un vieux
+inline void updateHistory(int16_t& entry, int bonus)
+{
+    entry = static_cast<int16_t>(entry + bonus - entry * std::abs(bonus) / HISTORY_MAX);
+}
+
+// [couleur][départ][arrivée] : les coups calmes qui ont provoqué des coupures, toutes positions confondues
+using ButterflyHistory = std::array<std::array<std::array<int16_t, 64>, 64>, 2>;
+// [pièce][arrivée] -> score, pour un coup précédent donné
+using PieceToHistory = std::array<std::array<int16_t, 64>, 12>;
+// [pièce][arrivée] du coup précédent (1 ou 2 demi-coups plus tôt) -> historique du coup courant
+using ContinuationHistory = std::array<std::array<PieceToHistory, 64>, 12>;
+// [pièce][arrivée] du coup précédent -> la réfutation qui a marché
+using CounterMoveTable = std::array<std::array<Move, 64>, 12>;
+
+// Tables d'un thread de recherche (environ 1,2 Mo, à mettre sur le tas)
+struct HistoryTables {
+    ButterflyHistory    butterfly;
+    ContinuationHistory continuation;
+    CounterMoveTable    counterMoves;
+
+    void clear();
+};
+
+/**
+ * @brief Sélection des coups par étapes.
+ *
+ * Ordre : coup de la table, prises gagnantes (MVV-LVA, filtrées par SEE), coups "tueurs", contre-coup,
+ * coups calmes triés par historique, et enfin les prises perdantes. Les coups calmes ne sont générés et notés
+ * que si aucune des étapes précédentes n'a provoqué de coupure : dans un arbre bien ordonné, c'est la majorité des noeuds.
+ */
+class MovePicker {
+public:
+    MovePicker(const BoardState& board, Move ttMove, const Move* killers, Move counterMove, const HistoryTables& history,
+               const PieceToHistory* const* continuation);
+
+    // Recherche de repos : seulement les prises qui ne perdent pas de matériel (SEE >= 0).
+    // En échec, toutes les parades sont rendues, comme dans la recherche principale.
+    MovePicker(const BoardState& board, Move ttMove, const HistoryTables& history);
+
+    // Coup suivant, Move::none() quand il n'y en a plus
+    Move next();
+
+private:
+    enum class Stage {
+        TTMove,
+        GenerateCaptures,
+        Captures,
+        Killer1,
+        Killer2,
+        CounterMove,
+        GenerateQuiets,
+        Quiets,
+        BadCaptures,
+        Done,
+    };
+
+    struct ScoredMove {
+        Move move;
+        int  score;
+    };
+
+    bool isSpecial(Move move) const { return move == m_ttMove || move == m_killers[0] || move == m_killers[1] || move == m_counterMove; }
+    bool isQuietCandidate(Move move) const;
+    void scoreCaptures();
+    void scoreQuiets();
+
+    const BoardState&            m_board;
+    const HistoryTables&         m_history;
+    const PieceToHistory* const* m_continuation; // [0] = 1 demi-coup avant, [1] = 2 demi-coups avant (nullptr si aucun)
+    Move                         m_ttMove;
+    Move                         m_killers[2];
+    Move                         m_counterMove;
+    Stage                        m_stage;
+    bool                         m_quiescence = false;
+
+    MoveList                                   m_moves;
+    std::array<ScoredMove, MoveList::Capacity> m_scored;
+    size_t                                     m_count   = 0;
+    size_t                                     m_current = 0;
+    MoveList                                   m_badCaptures; // SEE < 0, gardées pour la fin
+};
@@ -0,0 +1,385 @@
+#include "Nnue.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+    #include <fstream>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define NNUE_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define NNUE_TARGET(isa) // MSVC accepte les intrinsèques AVX2 sans option de compilation
+    #else
+        #include <cpuid.h>
+        // Chaque noyau est compilé pour son jeu d'instructions, sans imposer -mavx2 à tout le programme
+        #define NNUE_TARGET(isa) __attribute__((target(isa)))
+    #endif
+#endif
+
+namespace Nnue {
+
+namespace {
+
+constexpr char   MAGIC[8]    = {'C', 'H', 'E', 'S', 'S', 'N', 'N', '1'};
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t FILE_SIZE   = HEADER_SIZE + sizeof(int16_t) * (static_cast<size_t>(INPUTS) * HIDDEN + HIDDEN + 2 * HIDDEN + 1);
+
+// dst = src + somme des lignes add - somme des lignes sub, sur HIDDEN valeurs
+using UpdateFn = void (*)(const int16_t* src, int16_t* dst, const int16_t* const* add, int addCount, const int16_t* const* sub, int subCount);
+// Somme de ClippedReLU(accumulateur) * poids, sur les deux moitiés
+using OutputFn = int32_t (*)(const int16_t* us, const int16_t* them, const int16_t* weights);
+
+// --- Noyau scalaire : la référence, partout disponible ---
+
+void updateScalar(const int16_t* src, int16_t* dst, const int16_t* const* add, int addCount, const int16_t* const* sub, int subCount)
+{
+    for (int i = 0; i < HIDDEN; ++i)
+    {
+        int value = src[i];
+        for (int a = 0; a < addCount; ++a)
+            value += add[a][i];
+        for (int s = 0; s < subCount; ++s)
+            value -= sub[s][i];
+        dst[i] = static_cast<int16_t>(value);
+    }
+}
+
+int32_t outputScalar(const int16_t* us, const int16_t* them, const int16_t* weights)
+{
+    int32_t sum = 0;
+    for (int i = 0; i < HIDDEN; ++i)
+    {
+        sum += std::clamp<int32_t>(us[i], 0, QA) * weights[i];
+        sum += std::clamp<int32_t>(them[i], 0, QA) * weights[HIDDEN + i];
+    }
+    return sum;
+}
+
+#if NNUE_X86
+
+// --- SSE4.1 : 8 valeurs int16 par registre ---
+
+NNUE_TARGET("sse4.1")
+void updateSse41(const int16_t* src, int16_t* dst, const int16_t* const* add, int addCount, const int16_t* const* sub, int subCount)
+{
+    for (int i = 0; i < HIDDEN; i += 8)
+    {
+        __m128i value = _mm_load_si128(reinterpret_cast<const __m128i*>(src + i));
+        for (int a = 0; a < addCount; ++a)
+            value = _mm_add_epi16(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(add[a] + i)));
+        for (int s = 0; s < subCount; ++s)
+            value = _mm_sub_epi16(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(sub[s] + i)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), value);
+    }
+}
+
+NNUE_TARGET("sse4.1")
+int32_t outputSse41(const int16_t* us, const int16_t* them, const int16_t* weights)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i qa   = _mm_set1_epi16(QA);
+    __m128i       sum  = _mm_setzero_si128();
+    for (int i = 0; i < HIDDEN; i += 8)
+    {
+        const __m128i a = _mm_min_epi16(_mm_max_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(us + i)), zero), qa);
+        const __m128i b = _mm_min_epi16(_mm_max_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(them + i)), zero), qa);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i))));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(b, _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + HIDDEN + i))));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+// --- AVX2 : 16 valeurs int16 par registre ---
+
+NNUE_TARGET("avx2")
+void updateAvx2(const int16_t* src, int16_t* dst, const int16_t* const* add, int addCount, const int16_t* const* sub, int subCount)
+{
+    for (int i = 0; i < HIDDEN; i += 16)
+    {
+        __m256i value = _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i));
+        for (int a = 0; a < addCount; ++a)
+            value = _mm256_add_epi16(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(add[a] + i)));
+        for (int s = 0; s < subCount; ++s)
+            value = _mm256_sub_epi16(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sub[s] + i)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), value);
+    }
+}
+
+NNUE_TARGET("avx2")
+int32_t outputAvx2(const int16_t* us, const int16_t* them, const int16_t* weights)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i qa   = _mm256_set1_epi16(QA);
+    __m256i       sum  = _mm256_setzero_si256();
+    for (int i = 0; i < HIDDEN; i += 16)
+    {
+        const __m256i a = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(us + i)), zero), qa);
+        const __m256i b = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(them + i)), zero), qa);
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i))));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(b, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + HIDDEN + i))));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half         = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+    half         = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+    return _mm_cvtsi128_si32(half);
+}
+
+void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4])
+{
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int values[4];
+    __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<unsigned>(values[i]);
+    #else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+}
+
+// Registres que le système sauvegarde aux changements de contexte (bits 1-2 : XMM et YMM)
+uint64_t xgetbv0()
+{
+    #if defined(_MSC_VER) && !defined(__clang__)
+    return _xgetbv(0);
+    #else
+    unsigned eax = 0;
+    unsigned edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+    #endif
+}
+
+#endif // NNUE_X86
+
+struct Kernels {
+    UpdateFn update;
+    OutputFn output;
+};
+
+const Kernels& kernelsFor(Kernel kernel)
+{
+#if NNUE_X86
+    static const Kernels sse41{updateSse41, outputSse41};
+    static const Kernels avx2{updateAvx2, outputAvx2};
+    if (kernel == Kernel::Avx2)
+        return avx2;
+    if (kernel == Kernel::Sse41)
+        return sse41;
+#endif
+    static const Kernels scalar{updateScalar, outputScalar};
+    return scalar;
+}
+
+// Numéro de l'entrée d'une pièce vue par un camp : ses pièces d'abord, et l'échiquier retourné pour les noirs
+int featureIndex(PieceColor perspective, PieceColor color, PieceType type, int sq)
+{
+    const int relativeSquare = perspective == PieceColor::White ? sq : sq ^ 56;
+    return ((color == perspective ? 0 : 6) + typeIndex(type)) * 64 + relativeSquare;
+}
+
+} // namespace
+
+Kernel detectKernel()
+{
+#if NNUE_X86
+    unsigned regs[4];
+    cpuid(0, 0, regs);
+    const unsigned maxLeaf = regs[0];
+
+    cpuid(1, 0, regs);
+    const bool sse41   = (regs[2] >> 19) & 1;
+    const bool osxsave = (regs[2] >> 27) & 1;
+    const bool avx     = (regs[2] >> 28) & 1;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx && (xgetbv0() & 6) == 6)
+    {
+        cpuid(7, 0, regs);
+        avx2 = (regs[1] >> 5) & 1;
+    }
+
+    if (avx2)
+        return Kernel::Avx2;
+    if (sse41)
+        return Kernel::Sse41;
+#endif
+    return Kernel::Scalar;
+}
+
+const char* kernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::Avx2:
+        return "AVX2";
+    case Kernel::Sse41:
+        return "SSE4.1";
+    default:
+        return "scalaire";
+    }
+}
+
+void Network::setKernel(Kernel kernel)
+{
+    m_kernel = std::min(kernel, detectKernel());
+}
+
+bool Network::load(const std::string& path)
+{
+    unload();
+
+#if defined(_WIN32)
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return false;
+    m_size = static_cast<size_t>(file.tellg());
+    m_data = ::operator new(m_size);
+    file.seekg(0);
+    if (!file.read(static_cast<char*>(m_data), static_cast<std::streamsize>(m_size)))
+    {
+        unload();
+        return false;
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) != FILE_SIZE)
+    {
+        ::close(fd);
+        return false;
+    }
+    // Les pages ne sont lues qu'au premier accès, et partagées entre les processus qui chargent le même réseau
+    void* data = ::mmap(nullptr, FILE_SIZE, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+    m_data = data;
+    m_size = FILE_SIZE;
+#endif
+
+    const char* bytes = static_cast<const char*>(m_data);
+    uint32_t    dims[2];
+    std::memcpy(dims, bytes + sizeof(MAGIC), sizeof(dims));
+    if (m_size != FILE_SIZE || std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || dims[0] != INPUTS || dims[1] != HIDDEN)
+    {
+        unload();
+        return false;
+    }
+
+    m_featureWeights = reinterpret_cast<const int16_t*>(bytes + HEADER_SIZE);
+    m_featureBiases  = m_featureWeights + static_cast<size_t>(INPUTS) * HIDDEN;
+    m_outputWeights  = m_featureBiases + HIDDEN;
+    m_outputBias     = m_outputWeights[2 * HIDDEN];
+    m_path           = path;
+    return true;
+}
+
+void Network::unload()
+{
+    if (m_data)
+    {
+#if defined(_WIN32)
+        ::operator delete(m_data);
+#else
+        ::munmap(m_data, m_size);
+#endif
+    }
+    m_data           = nullptr;
+    m_size           = 0;
+    m_featureWeights = m_featureBiases = m_outputWeights = nullptr;
+    m_outputBias     = 0;
+    m_path.clear();
+}
+
+void Network::refresh(const BoardState& board, Accumulator& accumulator) const
+{
+    const Kernels& kernels = kernelsFor(m_kernel);
+    for (int perspective = 0; perspective < 2; ++perspective)
+    {
+        const PieceColor view   = perspective == 0 ? PieceColor::White : PieceColor::Black;
+        int16_t*         values = accumulator.values[perspective];
+        std::memcpy(values, m_featureBiases, sizeof(int16_t) * HIDDEN);
+
+        Bitboard occupied = board.occupancy();
+        while (occupied)
+        {
+            const int      sq    = popLsb(occupied);
+            const Piece    piece = board.get(sq);
+            const int16_t* row   = featureRow(featureIndex(view, piece.color, piece.type, sq));
+            kernels.update(values, values, &row, 1, nullptr, 0);
+        }
+    }
+}
+
+void Network::update(const BoardState& board, Move move, const Accumulator& parent, Accumulator& child) const
+{
+    struct Change {
+        PieceColor color;
+        PieceType  type;
+        int        sq;
+    };
+
+    // Au plus deux pièces posées et deux retirées (roque, prise avec promotion)
+    Change           added[2];
+    Change           removed[2];
+    int              addCount    = 0;
+    int              removeCount = 0;
+    const int        from        = move.from();
+    const int        to          = move.to();
+    const PieceColor us          = board.sideToMove();
+    const PieceType  moved       = board.typeAt(from);
+
+    if (move.isCastling())
+    {
+        const int rank     = rankOf(from);
+        const int rookFrom = makeSquare(move.flags() == KingCastle ? 7 : 0, rank);
+        const int rookTo   = makeSquare(move.flags() == KingCastle ? 5 : 3, rank);
+        removed[removeCount++] = {us, PieceType::King, from};
+        removed[removeCount++] = {us, PieceType::Rook, rookFrom};
+        added[addCount++]      = {us, PieceType::King, to};
+        added[addCount++]      = {us, PieceType::Rook, rookTo};
+    }
+    else
+    {
+        removed[removeCount++] = {us, moved, from};
+        added[addCount++]      = {us, move.isPromotion() ? move.promotionType() : moved, to};
+        if (move.isEnPassant())
+            removed[removeCount++] = {~us, PieceType::Pawn, to + (us == PieceColor::White ? -8 : 8)};
+        else if (!board.isEmpty(to))
+            removed[removeCount++] = {~us, board.typeAt(to), to};
+    }
+
+    const Kernels& kernels = kernelsFor(m_kernel);
+    for (int perspective = 0; perspective < 2; ++perspective)
+    {
+        const PieceColor view = perspective == 0 ? PieceColor::White : PieceColor::Black;
+        const int16_t*   addRows[2];
+        const int16_t*   removeRows[2];
+        for (int i = 0; i < addCount; ++i)
+            addRows[i] = featureRow(featureIndex(view, added[i].color, added[i].type, added[i].sq));
+        for (int i = 0; i < removeCount; ++i)
+            removeRows[i] = featureRow(featureIndex(view, removed[i].color, removed[i].type, removed[i].sq));
+        kernels.update(parent.values[perspective], child.values[perspective], addRows, addCount, removeRows, removeCount);
+    }
+}
+
+int Network::evaluate(const Accumulator& accumulator, PieceColor sideToMove) const
+{
+    const int     us     = colorIndex(sideToMove);
+    const int32_t output = kernelsFor(m_kernel).output(accumulator.values[us], accumulator.values[1 - us], m_outputWeights) + m_outputBias;
+    return static_cast<int>(static_cast<int64_t>(output) * SCALE / (QA * QB));
+}
+
+} // namespace Nnue
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../Core/BoardState.hpp"
+#include "../Core/Move.hpp"
+
+// Évaluateur neuronal optionnel, façon NNUE : 768 entrées (couleur relative x type x case, vues par chaque camp)
+// -> 2 x 256 neurones cachés (int16, "accumulateur") -> ClippedReLU -> 1 sortie.
+// L'accumulateur est mis à jour à chaque coup en ajoutant / retirant les lignes des pièces qui bougent,
+// jamais recalculé sur tout l'échiquier pendant la recherche.
+namespace Nnue {
+
+constexpr int INPUTS = 768;
+constexpr int HIDDEN = 256;
+constexpr int QA     = 255; // quantification de la couche cachée (et borne de la ClippedReLU)
+constexpr int QB     = 64;  // quantification des poids de sortie
+constexpr int SCALE  = 400; // sortie du réseau -> centipions
+
+// Une moitié par point de vue : [0] vu par les blancs, [1] vu par les noirs
+struct alignas(32) Accumulator {
+    int16_t values[2][HIDDEN];
+};
+
+// Jeu d'instructions utilisé par les noyaux de calcul, choisi à l'exécution (cpuid)
+enum class Kernel {
+    Scalar,
+    Sse41,
+    Avx2,
+};
+
+// Meilleur noyau que le processeur (et le système) sait exécuter
+Kernel      detectKernel();
+const char* kernelName(Kernel kernel);
+
+/**
+ * @brief Poids du réseau, projetés en mémoire depuis le fichier (mmap, sans copie).
+ *
+ * Format (petit-boutiste) : "CHESSNN1", uint32 entrées (768), uint32 neurones cachés (256), puis en int16 :
+ * poids d'entrée [768][256], biais cachés [256], poids de sortie [2 x 256] (camp au trait d'abord), biais de sortie.
+ * Lecture seule une fois chargé : les threads de recherche le partagent sans synchronisation.
+ */
+class Network {
+public:
+    Network() : m_kernel(detectKernel()) {}
+    ~Network() { unload(); }
+
+    Network(const Network&)            = delete;
+    Network& operator=(const Network&) = delete;
+
+    // Remplace le réseau courant ; en cas d'échec (fichier absent, taille ou en-tête incorrects), plus aucun réseau n'est chargé
+    bool load(const std::string& path);
+    void unload();
+
+    bool               isLoaded() const { return m_data != nullptr; }
+    const std::string& path() const { return m_path; }
+    Kernel             kernel() const { return m_kernel; }
+
+    // Pour comparer les noyaux entre eux ; ramené au meilleur noyau disponible si le processeur ne sait pas l'exécuter
+    void setKernel(Kernel kernel);
+
+    // Recalcule l'accumulateur depuis zéro (à la racine de la recherche)
+    void refresh(const BoardState& board, Accumulator& accumulator) const;
+
+    // child = parent + effet du coup ; board est la position AVANT le coup
+    void update(const BoardState& board, Move move, const Accumulator& parent, Accumulator& child) const;
+
+    // Score en centipions du point de vue du camp au trait
+    int evaluate(const Accumulator& accumulator, PieceColor sideToMove) const;
+
+private:
+    const int16_t* featureRow(int feature) const { return m_featureWeights + static_cast<size_t>(feature) * HIDDEN; }
+
+    Kernel         m_kernel;
+    std::string    m_path;
+    void*          m_data = nullptr; // fichier projeté (ou copié en mémoire là où mmap n'existe pas)
+    size_t         m_size = 0;
+    const int16_t* m_featureWeights = nullptr;
+    const int16_t* m_featureBiases  = nullptr;
+    const int16_t* m_outputWeights  = nullptr;
+    int16_t        m_outputBias     = 0;
+};
+
+} // namespace Nnue
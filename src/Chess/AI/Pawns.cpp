@@ -0,0 +1,74 @@
+#include "Pawns.hpp"
+
+namespace {
+
+constexpr Psqt::Score DOUBLED  = {-10, -25};
+constexpr Psqt::Score ISOLATED = {-8, -15};
+
+// Bonus des pions passés selon leur rangée, vue du camp du pion
+constexpr Psqt::Score PASSED[8] = {{0, 0}, {5, 10}, {5, 15}, {10, 25}, {25, 45}, {45, 80}, {70, 120}, {0, 0}};
+
+Bitboard adjacentFiles(int sq)
+{
+    return shiftEast(fileBB(sq)) | shiftWest(fileBB(sq));
+}
+
+// Cases devant le pion, sur sa colonne et les deux voisines : aucun pion adverse ne doit s'y trouver pour qu'il soit passé
+Bitboard passedSpan(PieceColor color, int sq)
+{
+    const Bitboard files = fileBB(sq) | adjacentFiles(sq);
+    const int      rank  = rankOf(sq);
+    const Bitboard ahead = color == PieceColor::White ? (rank == 7 ? 0 : ~0ULL << (8 * (rank + 1))) : (rank == 0 ? 0 : ~0ULL >> (8 * (8 - rank)));
+    return files & ahead;
+}
+
+Psqt::Score evaluateSide(const BoardState& board, PieceColor color, Bitboard& passed)
+{
+    const Bitboard ours   = board.pieces(color, PieceType::Pawn);
+    const Bitboard theirs = board.pieces(~color, PieceType::Pawn);
+
+    Psqt::Score score;
+    Bitboard    pawns = ours;
+    while (pawns)
+    {
+        const int sq = popLsb(pawns);
+
+        // Doublé : un autre pion du même camp devant lui (seul celui de derrière est pénalisé)
+        if (ours & passedSpan(color, sq) & fileBB(sq))
+            score += DOUBLED;
+        if (!(ours & adjacentFiles(sq)))
+            score += ISOLATED;
+        if (!(theirs & passedSpan(color, sq)) && !(ours & passedSpan(color, sq) & fileBB(sq)))
+        {
+            passed |= squareBB(sq);
+            score += PASSED[color == PieceColor::White ? rankOf(sq) : 7 - rankOf(sq)];
+        }
+    }
+    return score;
+}
+
+void increment(std::atomic<uint64_t>& counter)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+const PawnTable::Entry& PawnTable::probe(const BoardState& board)
+{
+    const uint64_t key   = board.pawnKey();
+    Entry&         entry = m_entries[key & (m_entries.size() - 1)];
+    increment(m_probes);
+    // Une entrée jamais écrite (clé 0) convient telle quelle aux positions sans pion
+    if (entry.key == key)
+    {
+        increment(m_hits);
+        return entry;
+    }
+
+    entry.key       = key;
+    entry.passed[0] = entry.passed[1] = 0;
+    entry.score     = evaluateSide(board, PieceColor::White, entry.passed[0]);
+    entry.score -= evaluateSide(board, PieceColor::Black, entry.passed[1]);
+    return entry;
+}
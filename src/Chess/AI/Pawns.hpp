@@ -0,0 +1,32 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include "../Core/BoardState.hpp"
+
+// Structure de pions (pions passés, isolés, doublés), mise en cache par signature des pions :
+// elle ne change qu'aux coups de pion et aux prises de pion, soit rarement dans un arbre de recherche.
+class PawnTable {
+public:
+    struct Entry {
+        uint64_t    key = 0;
+        Psqt::Score score; // positif = bon pour les blancs
+        Bitboard    passed[2]{0, 0};
+    };
+
+    explicit PawnTable(size_t entries = 16384) : m_entries(std::bit_floor(std::max<size_t>(entries, 1))) {}
+
+    // Entrée de la position, calculée si elle n'était pas en cache
+    const Entry& probe(const BoardState& board);
+
+    // Lus par les autres threads pour les statistiques
+    uint64_t probes() const { return m_probes.load(std::memory_order_relaxed); }
+    uint64_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<Entry>    m_entries; // taille puissance de 2
+    std::atomic<uint64_t> m_probes{0};
+    std::atomic<uint64_t> m_hits{0};
+};
@@ -0,0 +1,679 @@
+#include "Search.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../Core/MoveGen.hpp"
+#include "Evaluation.hpp"
+#include "MovePicker.hpp"
+#include "Nnue.hpp"
+#include "TranspositionTable.hpp"
+
+namespace {
+
+// Compteurs écrits par un seul thread (et lus par les autres) : pas besoin d'un fetch_add
+void increment(std::atomic<uint64_t>& counter)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// Décalage des profondeurs des aides : l'aide i saute certaines itérations selon ces deux tables,
+// pour que les threads ne cherchent pas tous la même profondeur au même moment
+constexpr int SKIP_SIZE[]  = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+constexpr int SKIP_PHASE[] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+// Marge de l'élagage "delta" de la recherche de repos
+constexpr int DELTA_MARGIN = 200;
+
+} // namespace
+
+Search::Search(TranspositionTable& tt, int threadIndex)
+    : m_tt(tt), m_threadIndex(threadIndex), m_history(std::make_unique<HistoryTables>()), m_evalTables(std::make_unique<EvalTables>())
+{
+}
+
+Search::~Search() = default;
+
+void Search::makeMove(Move move, int ply)
+{
+    if (m_limits.network)
+        m_limits.network->update(m_board, move, m_accumulators[ply], m_accumulators[ply + 1]);
+    m_board.makeMove(move);
+}
+
+void Search::makeNullMove(int ply)
+{
+    if (m_limits.network)
+        m_accumulators[ply + 1] = m_accumulators[ply];
+    m_board.makeNullMove();
+}
+
+int Search::staticEval(int ply) const
+{
+    return m_limits.network ? m_limits.network->evaluate(m_accumulators[ply], m_board.sideToMove()) : evaluate(m_board, *m_evalTables);
+}
+
+// L'horloge (et le drapeau d'arrêt) ne sont lus qu'environ tous les quarts de milliseconde : l'intervalle (en noeuds)
+// suit la vitesse mesurée, assez court pour tenir la limite dure et s'arrêter sur demande en moins d'une milliseconde,
+// assez long pour ne pas coûter dans les profils
+bool Search::shouldStop()
+{
+    if (m_aborted)
+        return true;
+
+    if (--m_checkCountdown <= 0)
+    {
+        const int64_t elapsedUs = m_time.elapsedUs();
+        m_checkInterval         = static_cast<int>(std::clamp<int64_t>(static_cast<int64_t>(nodes()) * 250 / std::max<int64_t>(elapsedUs, 1), 128, 16384));
+        m_checkCountdown        = m_checkInterval;
+        if (m_stop->load(std::memory_order_relaxed) || (!pondering() && m_time.enabled() && elapsedUs >= m_time.hardMs() * 1000))
+            m_aborted = true;
+    }
+    if (m_limits.nodes > 0 && nodes() >= m_limits.nodes)
+        m_aborted = true;
+    return m_aborted;
+}
+
+// Le chronomètre tourne depuis le début de la réflexion : au "ponder hit", tout le temps passé sur le coup attendu
+// est déjà acquis, et si le budget est consommé on rend le résultat de la dernière itération tout de suite
+bool Search::pondering()
+{
+    if (m_pondering && !m_limits.ponder->load(std::memory_order_acquire))
+    {
+        m_pondering = false;
+        if (m_time.softLimitReached() || m_time.hardLimitReached())
+            m_aborted = true;
+    }
+    return m_pondering;
+}
+
+// Réponse attendue au meilleur coup : le coup de la table dans la position d'après, s'il y est et s'il est légal
+Move Search::expectedReply(Move best)
+{
+    if (!best)
+        return Move::none();
+
+    m_board.makeMove(best);
+    TTData   tt;
+    Move     reply = Move::none();
+    MoveList moves;
+    generateLegalMoves(m_board, moves);
+    if (m_tt.probe(m_board.key(), tt) && std::find(moves.begin(), moves.end(), tt.move) != moves.end())
+        reply = tt.move;
+    m_board.unmakeMove();
+    return reply;
+}
+
+// Variante principale : le meilleur coup de la racine, puis les coups de la table tant qu'ils sont légaux.
+// Pas de table triangulaire à tenir pendant la recherche ; la fin de variante peut être écrasée, le début ne l'est presque jamais.
+void Search::extractPv(int score, PvLine& line)
+{
+    line.score  = score;
+    line.length = 0;
+    Move move   = m_rootBest;
+    while (move && line.length < MAX_PV_LENGTH)
+    {
+        line.moves[line.length++] = move;
+        m_board.makeMove(move);
+        if (m_board.isRepetition() || m_board.halfmoveClock() >= 100)
+            break;
+
+        TTData   tt;
+        MoveList moves;
+        generateLegalMoves(m_board, moves);
+        move = m_tt.probe(m_board.key(), tt) && std::find(moves.begin(), moves.end(), tt.move) != moves.end() ? tt.move : Move::none();
+    }
+    for (int i = 0; i < line.length; ++i)
+        m_board.unmakeMove();
+}
+
+// Multi-PV : les coups de tête des variantes déjà trouvées à cette profondeur ne sont plus cherchés à la racine
+bool Search::rootExcluded(Move move) const
+{
+    for (int i = 0; i < m_pvIndex; ++i)
+    {
+        if (m_lines[i].moves[0] == move)
+            return true;
+    }
+    return false;
+}
+
+bool Search::skipDepth(int depth) const
+{
+    if (m_threadIndex == 0)
+        return false;
+
+    const int i = (m_threadIndex - 1) % 20;
+    return ((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) % 2 != 0;
+}
+
+int Search::alphaBeta(int alpha, int beta, int depth, int ply)
+{
+    const SearchParams& params   = m_limits.params;
+    const bool          rootNode = ply == 0;
+    const bool          pvNode   = beta - alpha > 1; // fenêtre ouverte : noeud de la variation principale
+
+    increment(m_nodes);
+    m_selDepth = std::max(m_selDepth, ply);
+    if (!rootNode && (m_board.halfmoveClock() >= 100 || m_board.isRepetition()))
+        return 0;
+
+    if (ply >= MAX_PLY - 1)
+        return staticEval(ply);
+    if (depth <= 0)
+        return quiescence(alpha, beta, ply);
+
+    StackEntry* ss = &m_stack[ply + 2]; // ss[-1], ss[-2] : les deux demi-coups précédents
+    (ss + 2)->killers[0] = (ss + 2)->killers[1] = Move::none();
+    (ss + 1)->excluded                          = Move::none();
+
+    // Pendant le test de singularité, la position est la même que celle du noeud englobant :
+    // la table n'y est ni consultée ni mise à jour
+    const Move     excluded = ss->excluded;
+    const uint64_t key      = m_board.key();
+    TTData         tt;
+    bool           ttHit = false;
+    if (!excluded)
+    {
+        ttHit = m_tt.probe(key, tt);
+        increment(m_ttProbes);
+        if (ttHit)
+            increment(m_ttHits);
+    }
+    const int ttScore = ttHit ? scoreFromTT(tt.score, ply) : VALUE_NONE;
+    if (!pvNode && ttHit && tt.depth >= depth)
+    {
+        if (tt.bound == BOUND_EXACT
+            || (tt.bound == BOUND_LOWER && ttScore >= beta)
+            || (tt.bound == BOUND_UPPER && ttScore <= alpha))
+            return ttScore;
+    }
+
+    // Évaluation statique ; la table l'affine quand sa borne va dans le bon sens
+    const PieceColor us      = m_board.sideToMove();
+    const bool       inCheck = m_board.inCheck();
+    int              eval    = VALUE_NONE;
+    if (inCheck)
+        ss->staticEval = VALUE_NONE;
+    else
+    {
+        ss->staticEval = eval = staticEval(ply);
+        if (ttHit && (tt.bound & (ttScore > eval ? BOUND_LOWER : BOUND_UPPER)))
+            eval = ttScore;
+    }
+    // La position s'améliore-t-elle depuis notre coup précédent ? On élague alors plus franchement
+    const bool improving = !inCheck && ss[-2].staticEval != VALUE_NONE && ss->staticEval > ss[-2].staticEval;
+
+    if (!pvNode && !inCheck && !excluded)
+    {
+        // Razoring : très loin sous alpha près des feuilles, on vérifie directement avec la recherche de repos
+        if (params.razoring && depth <= params.razoringMaxDepth && eval + params.razoringMargin * depth <= alpha)
+        {
+            const int score = quiescence(alpha - 1, alpha, ply);
+            if (score < alpha)
+                return score;
+        }
+
+        // Futilité inverse : même en concédant une marge par demi-coup restant, on resterait au-dessus de bêta
+        if (params.reverseFutility && depth <= params.reverseFutilityMaxDepth
+            && eval - params.reverseFutilityMargin * (depth - improving) >= beta && eval < VALUE_MATE_IN_MAX_PLY)
+            return eval;
+
+        // Coup nul : si passer son tour suffit déjà à tenir bêta, un vrai coup le fera aussi.
+        // Jamais deux de suite, ni sans pièce (zugzwang des finales de pions)
+        if (params.nullMove && ss[-1].move && ply >= m_nullMoveMinPly && depth >= params.nullMoveMinDepth && eval >= beta
+            && beta > VALUE_MATED_IN_MAX_PLY && m_board.hasNonPawnMaterial(us))
+        {
+            const int reduction = params.nullMoveBase + depth / params.nullMoveDepthDivisor
+                                  + std::min((eval - beta) / params.nullMoveEvalDivisor, 3);
+            ss->move  = Move::none();
+            ss->piece = 0;
+            makeNullMove(ply);
+            int score = -alphaBeta(-beta, -beta + 1, depth - reduction, ply + 1);
+            unmakeMove();
+
+            if (shouldStop())
+                return 0;
+            if (score >= beta)
+            {
+                // Un mat trouvé après un coup nul n'est pas prouvé
+                if (score >= VALUE_MATE_IN_MAX_PLY)
+                    score = beta;
+                if (depth < 12 || m_nullMoveMinPly > 0)
+                    return score;
+
+                // En profondeur, on vérifie sans coup nul sur les premiers demi-coups : garde-fou contre le zugzwang
+                m_nullMoveMinPly = ply + 3 * (depth - reduction) / 4;
+                const int verified = alphaBeta(beta - 1, beta, depth - reduction, ply);
+                m_nullMoveMinPly = 0;
+                if (verified >= beta)
+                    return score;
+            }
+        }
+    }
+
+    // Historique de continuation et contre-coup : indexés par le(s) coup(s) qui ont mené ici
+    PieceToHistory* continuation[2] = {nullptr, nullptr};
+    for (int i = 0; i < 2; ++i)
+    {
+        const StackEntry& previous = ss[-1 - i];
+        if (previous.move)
+            continuation[i] = &m_history->continuation[previous.piece][previous.move.to()];
+    }
+    const Move counterMove = ss[-1].move ? m_history->counterMoves[ss[-1].piece][ss[-1].move.to()] : Move::none();
+
+    // Le coup de la table passe en premier ; à la racine, celui de l'itération précédente
+    const Move ttMove = (rootNode && m_rootBest) ? m_rootBest : ttHit ? tt.move : Move::none();
+    MovePicker picker(m_board, ttMove, ss->killers, counterMove, *m_history, continuation);
+
+    const int alphaOrig = alpha;
+    int       bestScore = -VALUE_INFINITE;
+    Move      bestMove  = Move::none();
+    int       moveCount = 0;
+    Move      quietsTried[64];
+    int       quietCount = 0;
+
+    for (Move move = picker.next(); move; move = picker.next())
+    {
+        if (move == excluded || (rootNode && rootExcluded(move)))
+            continue;
+
+        ++moveCount;
+        const bool quiet = !move.isCapture() && !move.isPromotion();
+        const int  piece = pieceIndex(us, m_board.typeAt(move.from()));
+
+        // Extension de singularité : si aucun autre coup n'approche le score du coup de la table, il est seul à tenir la position
+        int extension = 0;
+        if (params.singularExtension && !rootNode && !excluded && move == ttMove && depth >= params.singularMinDepth
+            && (tt.bound & BOUND_LOWER) && tt.depth >= depth - 3 && std::abs(ttScore) < VALUE_MATE_IN_MAX_PLY)
+        {
+            const int singularBeta = ttScore - params.singularMargin * depth;
+            ss->excluded           = move;
+            const int score        = alphaBeta(singularBeta - 1, singularBeta, (depth - 1) / 2, ply);
+            ss->excluded           = Move::none();
+
+            if (shouldStop())
+                return 0;
+            if (score < singularBeta)
+                extension = 1;
+            else if (singularBeta >= beta)
+                return singularBeta; // plusieurs coups dépassent bêta : coupure sans chercher plus loin
+        }
+
+        // Futilité : près des feuilles, un coup calme ne rattrapera pas l'écart avec alpha (sauf s'il donne échec)
+        const bool futile = params.futility && !rootNode && !inCheck && quiet && moveCount > 1 && bestScore > VALUE_MATED_IN_MAX_PLY
+                            && depth <= params.futilityMaxDepth && eval + params.futilityMargin * (depth + 1) <= alpha;
+
+        ss->move  = move;
+        ss->piece = piece;
+
+        // Le cluster de l'enfant arrive en cache pendant que makeMove travaille
+        m_tt.prefetch(m_board.keyAfter(move));
+        makeMove(move, ply);
+        const bool givesCheck = m_board.inCheck();
+        if (futile && !givesCheck)
+        {
+            unmakeMove();
+            continue;
+        }
+        if (params.checkExtension && givesCheck && extension == 0)
+            extension = 1;
+
+        const int newDepth = depth - 1 + extension;
+        int       score;
+        if (moveCount == 1)
+            score = -alphaBeta(-beta, -alpha, newDepth, ply + 1);
+        else
+        {
+            // Réduction des coups tardifs : les coups calmes mal classés sont d'abord cherchés moins profond
+            int reduction = 0;
+            if (params.lateMoveReduction && quiet && depth >= params.lmrMinDepth && moveCount > 1 + rootNode)
+            {
+                int history = m_history->butterfly[colorIndex(us)][move.from()][move.to()];
+                for (int i = 0; i < 2; ++i)
+                {
+                    if (continuation[i])
+                        history += (*continuation[i])[piece][move.to()];
+                }
+
+                int r = m_reductions[std::min(depth, 63)][std::min(moveCount, 63)];
+                r += (pvNode ? -100 : 0) + (improving ? 0 : 100) + (givesCheck ? -100 : 0) - history / 128;
+                reduction = std::clamp(r / 100, 0, std::max(newDepth - 1, 0));
+            }
+
+            // Fenêtre nulle d'abord (PVS) ; on ne recherche en grand qu'un coup qui bat alpha
+            score = -alphaBeta(-alpha - 1, -alpha, newDepth - reduction, ply + 1);
+            if (score > alpha && reduction > 0)
+                score = -alphaBeta(-alpha - 1, -alpha, newDepth, ply + 1);
+            if (pvNode && score > alpha && score < beta)
+                score = -alphaBeta(-beta, -alpha, newDepth, ply + 1);
+        }
+        unmakeMove();
+
+        if (shouldStop())
+            return 0;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestMove  = move;
+            if (rootNode)
+                m_rootBest = move;
+            if (score > alpha)
+            {
+                alpha = score;
+                if (alpha >= beta)
+                {
+                    ++m_cutoffs;
+                    if (moveCount == 1)
+                        ++m_firstMoveCutoffs;
+                    if (quiet)
+                        updateQuietStats(ss, continuation, move, quietsTried, quietCount, depth);
+                    break;
+                }
+            }
+        }
+
+        if (quiet && quietCount < 64)
+            quietsTried[quietCount++] = move;
+    }
+
+    if (moveCount == 0)
+        return excluded ? alpha : inCheck ? -VALUE_MATE + ply : 0;
+
+    // Les variantes secondaires de la racine ne disent rien du meilleur coup : on ne les stocke pas
+    if (!excluded && !(rootNode && m_pvIndex > 0))
+    {
+        const Bound bound = bestScore >= beta ? BOUND_LOWER : bestScore > alphaOrig ? BOUND_EXACT : BOUND_UPPER;
+        m_tt.store(key, bestMove, scoreToTT(bestScore, ply), depth, bound);
+    }
+    return bestScore;
+}
+
+// Recherche de repos : aux feuilles, on continue les prises jusqu'à une position calme,
+// pour ne pas évaluer au milieu d'un échange (effet d'horizon)
+int Search::quiescence(int alpha, int beta, int ply)
+{
+    increment(m_nodes);
+    m_selDepth = std::max(m_selDepth, ply);
+    if (ply >= MAX_PLY - 1)
+        return staticEval(ply);
+
+    const uint64_t key = m_board.key();
+    TTData         tt;
+    const bool     ttHit = m_tt.probe(key, tt);
+    increment(m_ttProbes);
+    if (ttHit)
+    {
+        increment(m_ttHits);
+        const int ttScore = scoreFromTT(tt.score, ply);
+        if (tt.bound == BOUND_EXACT
+            || (tt.bound == BOUND_LOWER && ttScore >= beta)
+            || (tt.bound == BOUND_UPPER && ttScore <= alpha))
+            return ttScore;
+    }
+
+    // "Stand pat" : hors échec, le camp au trait peut toujours refuser les prises
+    const bool inCheck   = m_board.inCheck();
+    int        bestScore = -VALUE_INFINITE;
+    int        standPat  = -VALUE_INFINITE;
+    if (!inCheck)
+    {
+        standPat = bestScore = staticEval(ply);
+        if (bestScore >= beta)
+            return bestScore;
+        alpha = std::max(alpha, bestScore);
+    }
+
+    const int  alphaOrig = alpha;
+    Move       bestMove  = Move::none();
+    int        moveCount = 0;
+    MovePicker picker(m_board, ttHit ? tt.move : Move::none(), *m_history);
+    for (Move move = picker.next(); move; move = picker.next())
+    {
+        ++moveCount;
+
+        // Delta : même en gagnant la pièce prise (plus une marge), on resterait sous alpha
+        if (!inCheck && !move.isPromotion())
+        {
+            const PieceType victim = move.isEnPassant() ? PieceType::Pawn : m_board.typeAt(move.to());
+            if (standPat + pieceValue(victim) + DELTA_MARGIN <= alpha)
+                continue;
+        }
+
+        m_tt.prefetch(m_board.keyAfter(move));
+        makeMove(move, ply);
+        const int score = -quiescence(-beta, -alpha, ply + 1);
+        unmakeMove();
+
+        if (shouldStop())
+            return 0;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            if (score > alpha)
+            {
+                bestMove = move;
+                alpha    = score;
+                if (alpha >= beta)
+                    break;
+            }
+        }
+    }
+
+    // En échec sans parade : mat
+    if (inCheck && moveCount == 0)
+        return -VALUE_MATE + ply;
+
+    const Bound bound = bestScore >= beta ? BOUND_LOWER : bestScore > alphaOrig ? BOUND_EXACT : BOUND_UPPER;
+    m_tt.store(key, bestMove, scoreToTT(bestScore, ply), 0, bound);
+    return bestScore;
+}
+
+// Le coup calme qui a provoqué la coupure devient tueur, contre-coup, et gagne de l'historique ;
+// les coups calmes essayés avant lui en perdent
+void Search::updateQuietStats(StackEntry* ss, PieceToHistory* const* continuation, Move best, const Move* quietsTried, int quietCount, int depth)
+{
+    const PieceColor us    = m_board.sideToMove();
+    const int        bonus = std::min(16 * depth * depth + 32 * depth, 1600);
+
+    if (ss->killers[0] != best)
+    {
+        ss->killers[1] = ss->killers[0];
+        ss->killers[0] = best;
+    }
+    if (ss[-1].move)
+        m_history->counterMoves[ss[-1].piece][ss[-1].move.to()] = best;
+
+    auto update = [&](Move move, int amount) {
+        const int piece = pieceIndex(us, m_board.typeAt(move.from()));
+        updateHistory(m_history->butterfly[colorIndex(us)][move.from()][move.to()], amount);
+        for (int i = 0; i < 2; ++i)
+        {
+            if (continuation[i])
+                updateHistory((*continuation[i])[piece][move.to()], amount);
+        }
+    };
+
+    update(best, bonus);
+    for (int i = 0; i < quietCount; ++i)
+        update(quietsTried[i], -bonus);
+}
+
+SearchInfo Search::run(const BoardState& root, const SearchLimits& limits, const std::atomic<bool>& stop, const InfoCallback& onIteration)
+{
+    m_board            = root;
+    m_limits           = limits;
+    m_stop             = &stop;
+    m_aborted          = false;
+    m_pondering        = limits.ponder && limits.ponder->load(std::memory_order_relaxed);
+    m_checkCountdown   = 1024;
+    m_checkInterval    = 1024;
+    m_rootBest         = Move::none();
+    m_pvIndex          = 0;
+    m_nullMoveMinPly   = 0;
+    m_cutoffs          = 0;
+    m_firstMoveCutoffs = 0;
+    m_history->clear();
+    for (StackEntry& entry : m_stack)
+        entry = StackEntry{};
+    m_nodes.store(0, std::memory_order_relaxed);
+    m_ttProbes.store(0, std::memory_order_relaxed);
+    m_ttHits.store(0, std::memory_order_relaxed);
+    m_time.start(limits, root.sideToMove());
+
+    // Table des réductions tardives : elle ne dépend que des réglages, on la refait à chaque recherche
+    for (int d = 1; d < 64; ++d)
+    {
+        for (int m = 1; m < 64; ++m)
+            m_reductions[d][m] = limits.params.lmrBase + static_cast<int>(std::log(d) * std::log(m) * 10000 / limits.params.lmrDivisor);
+    }
+
+    // Accumulateurs du réseau : celui de la racine est calculé en entier, les suivants coup par coup
+    if (limits.network)
+    {
+        if (!m_accumulators)
+            m_accumulators = std::make_unique<Nnue::Accumulator[]>(MAX_PLY + 1);
+        limits.network->refresh(m_board, m_accumulators[0]);
+    }
+
+    SearchInfo info;
+    MoveList   rootMoves;
+    generateLegalMoves(m_board, rootMoves);
+    if (rootMoves.empty())
+        return info;
+
+    // Toujours un coup à jouer, même si la première itération est interrompue
+    info.bestMove = rootMoves[0];
+
+    uint64_t  previousIterationNodes = 0;
+    Move      previousBest           = Move::none();
+    const int lineCount              = std::clamp(std::min(limits.multiPv, static_cast<int>(rootMoves.size())), 1, MAX_MULTIPV);
+    for (PvLine& line : m_lines)
+        line = PvLine{};
+    for (int depth = 1; depth <= std::min(limits.depth, MAX_PLY - 1); ++depth)
+    {
+        if (skipDepth(depth))
+            continue;
+
+        const uint64_t iterationStart = nodes();
+        m_selDepth                    = 0;
+
+        // Une recherche par variante, chacune sans les coups de tête des précédentes ; chaque variante repart
+        // du coup qu'elle avait à l'itération précédente
+        for (m_pvIndex = 0; m_pvIndex < lineCount; ++m_pvIndex)
+        {
+            m_rootBest          = m_lines[m_pvIndex].moves[0];
+            const int lineScore = alphaBeta(-VALUE_INFINITE, VALUE_INFINITE, depth, 0);
+            if (m_aborted)
+                break;
+            extractPv(lineScore, m_lines[m_pvIndex]);
+        }
+        m_pvIndex = 0;
+        if (m_aborted)
+            break;
+
+        std::stable_sort(m_lines.begin(), m_lines.begin() + lineCount, [](const PvLine& a, const PvLine& b) { return a.score > b.score; });
+        m_rootBest      = m_lines[0].moves[0];
+        const int score = m_lines[0].score;
+
+        // Facteur de branchement effectif : noeuds de cette itération / noeuds de la précédente
+        const uint64_t iterationNodes = nodes() - iterationStart;
+        info.branchingFactor          = previousIterationNodes ? static_cast<double>(iterationNodes) / previousIterationNodes : 0.0;
+        info.firstMoveCutoffRate      = m_cutoffs ? static_cast<double>(m_firstMoveCutoffs) / m_cutoffs : 0.0;
+        previousIterationNodes        = iterationNodes;
+
+        info.depth     = depth;
+        info.selDepth  = m_selDepth;
+        info.score     = score;
+        info.bestMove  = m_rootBest;
+        info.nodes     = nodes();
+        info.timeMs    = m_time.elapsedMs();
+        info.lineCount = lineCount;
+        std::copy(m_lines.begin(), m_lines.begin() + lineCount, info.lines.begin());
+        if (onIteration)
+            onIteration(info);
+
+        // Un mat trouvé ne deviendra pas meilleur en cherchant plus loin
+        if (std::abs(score) >= VALUE_MATE_IN_MAX_PLY)
+            break;
+
+        // Pendule : un seul coup légal se joue tout de suite, sinon on s'arrête quand le budget souple est consommé
+        const bool bestMoveChanged = previousBest && previousBest != m_rootBest;
+        previousBest               = m_rootBest;
+        if (!pondering() && m_time.enabled() && (rootMoves.size() == 1 || m_time.stopAfterIteration(bestMoveChanged)))
+            break;
+    }
+
+    // En réflexion sur le temps adverse, le coup ne part pas avant que l'adversaire ait joué (ou qu'on nous arrête)
+    while (!m_aborted && pondering() && !m_stop->load(std::memory_order_relaxed))
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    info.ponderMove = expectedReply(info.bestMove);
+    info.nodes      = nodes();
+    info.timeMs     = m_time.elapsedMs();
+    return info;
+}
+
+SearchInfo searchParallel(const BoardState& root, const SearchLimits& limits, TranspositionTable& tt, const std::atomic<bool>& stop,
+                          const Search::InfoCallback& onIteration)
+{
+    const unsigned threadCount = std::max(limits.threads, 1u);
+
+    std::vector<std::unique_ptr<Search>> searches;
+    for (unsigned i = 0; i < threadCount; ++i)
+        searches.push_back(std::make_unique<Search>(tt, static_cast<int>(i)));
+
+    tt.newSearch();
+
+    // Compteurs de tous les threads, plus le remplissage de la table
+    auto addTotals = [&searches, &tt](SearchInfo& info) {
+        info.nodes    = 0;
+        info.ttProbes = 0;
+        info.ttHits   = 0;
+        info.pawnProbes = info.pawnHits = info.materialProbes = info.materialHits = 0;
+        for (const auto& search : searches)
+        {
+            info.nodes += search->nodes();
+            info.ttProbes += search->ttProbes();
+            info.ttHits += search->ttHits();
+            info.pawnProbes += search->evalTables().pawns.probes();
+            info.pawnHits += search->evalTables().pawns.hits();
+            info.materialProbes += search->evalTables().material.probes();
+            info.materialHits += search->evalTables().material.hits();
+        }
+        info.hashfull = tt.hashfull();
+    };
+
+    // Les aides n'ont pas de limite propre : elles s'arrêtent quand le thread principal a fini
+    std::atomic<bool> helpersStop{false};
+    SearchLimits      helperLimits = limits;
+    helperLimits.movetimeMs        = 0;
+    helperLimits.timeMs[0]         = 0;
+    helperLimits.timeMs[1]         = 0;
+    helperLimits.nodes             = 0;
+    helperLimits.depth             = MAX_PLY - 1;
+    helperLimits.ponder            = nullptr;
+    helperLimits.multiPv           = 1;
+
+    std::vector<std::thread> helpers;
+    for (unsigned i = 1; i < threadCount; ++i)
+        helpers.emplace_back([&, i] { searches[i]->run(root, helperLimits, helpersStop); });
+
+    SearchInfo result = searches[0]->run(root, limits, stop, [&](const SearchInfo& info) {
+        SearchInfo total = info;
+        addTotals(total);
+        if (onIteration)
+            onIteration(total);
+    });
+
+    helpersStop.store(true, std::memory_order_relaxed);
+    for (std::thread& helper : helpers)
+        helper.join();
+
+    addTotals(result);
+    return result;
+}
@@ -0,0 +1,198 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "../Core/BoardState.hpp"
+#include "../Core/Move.hpp"
+#include "MovePicker.hpp"
+#include "TimeManager.hpp"
+
+class TranspositionTable;
+namespace Nnue {
+class Network;
+struct Accumulator;
+} // namespace Nnue
+struct EvalTables;
+
+constexpr int MAX_PLY        = 128;
+constexpr int VALUE_INFINITE = 32000;
+constexpr int VALUE_MATE     = 31000;
+constexpr int VALUE_NONE     = 32001; // pas d'évaluation statique (position en échec)
+constexpr int VALUE_MATED_IN_MAX_PLY = -VALUE_MATE + MAX_PLY; // en dessous : on se fait mater
+constexpr int VALUE_MATE_IN_MAX_PLY  = VALUE_MATE - MAX_PLY;  // au-dessus : on mate
+constexpr int MAX_MULTIPV   = 8;  // variantes cherchées au plus en parallèle (analyse)
+constexpr int MAX_PV_LENGTH = 32; // demi-coups gardés par variante
+
+// Réglages de la recherche sélective : chaque technique peut être coupée pour mesurer ce qu'elle apporte.
+// Les marges sont en centipions, les profondeurs en demi-coups.
+struct SearchParams {
+    bool nullMove          = true;
+    bool lateMoveReduction = true;
+    bool reverseFutility   = true;
+    bool futility          = true;
+    bool razoring          = true;
+    bool checkExtension    = true;
+    bool singularExtension = true;
+
+    // Coup nul : R = base + profondeur / depthDivisor + min((éval - bêta) / evalDivisor, 3)
+    int nullMoveMinDepth     = 3;
+    int nullMoveBase         = 3;
+    int nullMoveDepthDivisor = 3;
+    int nullMoveEvalDivisor  = 200;
+
+    // Réductions des coups tardifs : base + ln(profondeur) * ln(numéro du coup) / divisor (en centièmes)
+    int lmrBase     = 75;
+    int lmrDivisor  = 225;
+    int lmrMinDepth = 3;
+
+    int reverseFutilityMargin   = 80; // par demi-coup
+    int reverseFutilityMaxDepth = 8;
+    int futilityMargin          = 100; // par demi-coup, plus une base de même valeur
+    int futilityMaxDepth        = 6;
+    int razoringMargin          = 250; // par demi-coup, plus une base
+    int razoringMaxDepth        = 3;
+
+    int singularMinDepth = 8;
+    int singularMargin   = 2; // bêta singulier = score de la table - margin * profondeur
+};
+
+// Bornes de la recherche ; 0 = pas de limite de ce côté-là
+struct SearchLimits {
+    int          depth      = MAX_PLY - 1;
+    int64_t      movetimeMs = 0; // temps fixe par coup
+    uint64_t     nodes      = 0;
+    unsigned     threads    = 1; // threads de recherche (Lazy SMP) ; 1 = recherche séquentielle
+    int          multiPv    = 1; // nombre de meilleurs coups classés (analyse), au plus MAX_MULTIPV
+
+    // Pendule : temps restant et incrément par camp [blancs, noirs], coups jusqu'au prochain contrôle (0 = mort subite)
+    int64_t timeMs[2]      = {0, 0};
+    int64_t incrementMs[2] = {0, 0};
+    int     movesToGo      = 0;
+    int64_t moveOverheadMs = 10; // marge retirée du temps disponible (interface, latence)
+
+    SearchParams params;
+
+    // Réseau d'évaluation (chargé, lecture seule, partagé par les threads) ; nul = évaluation classique
+    const Nnue::Network* network = nullptr;
+
+    // Réflexion sur le temps de l'adversaire : tant que *ponder vaut true, pas de limite de temps et pas de coup rendu.
+    // Le passer à false ("ponder hit") fait de la recherche en cours la vraie, avec le temps déjà passé compté dedans.
+    const std::atomic<bool>* ponder = nullptr;
+};
+
+// Une variante : le coup de la racine puis la suite attendue, relue dans la table de transposition
+struct PvLine {
+    int                             score  = 0;
+    int                             length = 0;
+    std::array<Move, MAX_PV_LENGTH> moves{};
+};
+
+// Résultat d'une itération terminée de l'approfondissement itératif
+struct SearchInfo {
+    int      depth    = 0;
+    int      selDepth = 0; // plus grand demi-coup atteint (extensions et recherche de repos comprises)
+    int      score    = 0;
+    Move     bestMove = Move::none();
+    uint64_t nodes    = 0; // tous threads confondus
+    int64_t  timeMs   = 0;
+    uint64_t ttProbes = 0; // consultations de la table et réponses trouvées, tous threads confondus
+    uint64_t ttHits   = 0;
+    int      hashfull = 0; // remplissage de la table en pour mille
+    uint64_t pawnProbes     = 0; // caches de l'évaluation (structure de pions, matériel), tous threads confondus
+    uint64_t pawnHits       = 0;
+    uint64_t materialProbes = 0;
+    uint64_t materialHits   = 0;
+    Move     ponderMove     = Move::none(); // réponse attendue de l'adversaire (résultat final seulement)
+
+    // Meilleures variantes, de la meilleure à la moins bonne (une seule hors analyse) ; lines[0] commence par bestMove
+    int                             lineCount = 0;
+    std::array<PvLine, MAX_MULTIPV> lines{};
+
+    // Qualité de l'ordre des coups (thread principal) : plus le facteur de branchement est bas, moins on cherche
+    double branchingFactor     = 0.0; // noeuds de l'itération / noeuds de la précédente
+    double firstMoveCutoffRate = 0.0; // part des coupures obtenues dès le premier coup essayé
+};
+
+// Alpha-bêta (negamax) en approfondissement itératif, pour un thread.
+// La recherche travaille sur sa propre copie de la position, en makeMove / unmakeMove :
+// elle peut tourner sur un autre thread que celui de l'interface.
+class Search {
+public:
+    using InfoCallback = std::function<void(const SearchInfo&)>;
+
+    // threadIndex 0 = thread principal (celui qui rend le résultat), les autres sont des aides Lazy SMP
+    Search(TranspositionTable& tt, int threadIndex = 0);
+    ~Search();
+
+    // Cherche jusqu'à la limite ou jusqu'à ce que stop passe à true ; onIteration est appelé à chaque profondeur terminée.
+    // Renvoie le meilleur coup de la dernière itération (Move::none() s'il n'y a aucun coup légal).
+    SearchInfo run(const BoardState& root, const SearchLimits& limits, const std::atomic<bool>& stop, const InfoCallback& onIteration = {});
+
+    // Lus par les autres threads pendant la recherche
+    uint64_t nodes() const { return m_nodes.load(std::memory_order_relaxed); }
+    uint64_t ttProbes() const { return m_ttProbes.load(std::memory_order_relaxed); }
+    uint64_t ttHits() const { return m_ttHits.load(std::memory_order_relaxed); }
+    const EvalTables& evalTables() const { return *m_evalTables; }
+
+private:
+    // Ce que la recherche retient de chaque demi-coup de la branche courante
+    struct StackEntry {
+        Move move  = Move::none(); // coup joué depuis ce noeud
+        int  piece = 0;            // pieceIndex de la pièce jouée
+        Move killers[2]{Move::none(), Move::none()};
+        int  staticEval = VALUE_NONE;   // évaluation statique du noeud (VALUE_NONE en échec)
+        Move excluded   = Move::none(); // coup exclu pendant le test de singularité
+    };
+
+    // Jouer / défaire un coup dans l'arbre : la position, et l'accumulateur du réseau s'il y en a un
+    void makeMove(Move move, int ply);
+    void makeNullMove(int ply);
+    void unmakeMove() { m_board.unmakeMove(); }
+    int  staticEval(int ply) const;
+
+    int  alphaBeta(int alpha, int beta, int depth, int ply);
+    int  quiescence(int alpha, int beta, int ply);
+    void updateQuietStats(StackEntry* ss, PieceToHistory* const* continuation, Move best, const Move* quietsTried, int quietCount, int depth);
+    bool shouldStop();
+    bool pondering();
+    Move expectedReply(Move best);
+    void extractPv(int score, PvLine& line);
+    bool rootExcluded(Move move) const;
+    bool skipDepth(int depth) const;
+
+    TranspositionTable&                   m_tt;
+    int                                   m_threadIndex;
+    BoardState                            m_board;
+    SearchLimits                          m_limits;
+    const std::atomic<bool>*              m_stop    = nullptr;
+    bool                                  m_aborted = false;
+    bool                                  m_pondering = false; // en attente du coup de l'adversaire
+    int                                   m_checkCountdown = 1024;
+    int                                   m_checkInterval  = 1024; // noeuds entre deux lectures de l'horloge
+    std::atomic<uint64_t>                 m_nodes{0};
+    std::atomic<uint64_t>                 m_ttProbes{0};
+    std::atomic<uint64_t>                 m_ttHits{0};
+    TimeManager                           m_time;
+    Move                                  m_rootBest = Move::none(); // meilleur coup de l'itération en cours
+    int                                   m_pvIndex  = 0; // variante cherchée (multi-PV) : les coups des précédentes sont exclus
+    std::array<PvLine, MAX_MULTIPV>       m_lines{};
+    int                                   m_selDepth = 0;
+    int                                   m_nullMoveMinPly = 0; // pas de coup nul avant ce demi-coup (vérification)
+
+    // Réductions des coups tardifs, en centièmes de demi-coup : [profondeur][numéro du coup]
+    std::array<std::array<int, 64>, 64>   m_reductions{};
+
+    std::unique_ptr<HistoryTables>        m_history;
+    std::unique_ptr<EvalTables>           m_evalTables;
+    std::unique_ptr<Nnue::Accumulator[]>  m_accumulators; // un par demi-coup, alloué seulement avec un réseau
+    std::array<StackEntry, MAX_PLY + 4>   m_stack; // décalée de 2 : ss[-2] existe dès la racine
+    uint64_t                              m_cutoffs          = 0;
+    uint64_t                              m_firstMoveCutoffs = 0;
+};
+
+// Lazy SMP : limits.threads threads cherchent la même racine à des profondeurs décalées, en partageant la table.
+// Ils ne communiquent que par elle ; seul le thread principal rapporte ses itérations et donne le coup final.
+SearchInfo searchParallel(const BoardState& root, const SearchLimits& limits, TranspositionTable& tt, const std::atomic<bool>& stop,
+                          const Search::InfoCallback& onIteration = {});
@@ -0,0 +1,75 @@
+#include "See.hpp"
+#include "Evaluation.hpp"
+
+namespace {
+
+// Ordre des pièces de la moins chère à la plus chère, pour choisir le prochain preneur
+constexpr PieceType CAPTURE_ORDER[] = {PieceType::Pawn, PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen, PieceType::King};
+
+} // namespace
+
+bool seeGE(const BoardState& board, Move move, int threshold)
+{
+    // Roques, prises en passant et promotions : on ne s'embête pas, l'échange est supposé neutre
+    if (move.isCastling() || move.isEnPassant() || move.isPromotion())
+        return 0 >= threshold;
+
+    const int from = move.from();
+    const int to   = move.to();
+
+    // swap : ce que le camp qui vient de prendre gagne si l'adversaire s'arrête là, moins le seuil
+    int swap = pieceValue(board.typeAt(to)) - threshold;
+    if (swap < 0)
+        return false;
+
+    swap = pieceValue(board.typeAt(from)) - swap;
+    if (swap <= 0)
+        return true; // même si la pièce est reprise, le seuil est atteint
+
+    Bitboard         occupied  = board.occupancy() ^ squareBB(from) ^ squareBB(to);
+    PieceColor       stm       = board.get(from).color;
+    Bitboard         attackers = board.attackersTo(to, occupied);
+    const Bitboard   diagonals = board.pieces(PieceType::Bishop) | board.pieces(PieceType::Queen);
+    const Bitboard   lines     = board.pieces(PieceType::Rook) | board.pieces(PieceType::Queen);
+    bool             result    = true;
+
+    for (;;)
+    {
+        stm = ~stm;
+        attackers &= occupied;
+        const Bitboard stmAttackers = attackers & board.occupancy(stm);
+        if (!stmAttackers)
+            break;
+
+        result = !result;
+
+        // Prochain preneur : la pièce la moins chère ; en partant, elle peut découvrir un rayon X
+        PieceType type = PieceType::King;
+        Bitboard  bb   = 0;
+        for (PieceType candidate : CAPTURE_ORDER)
+        {
+            bb = stmAttackers & board.pieces(candidate);
+            if (bb)
+            {
+                type = candidate;
+                break;
+            }
+        }
+
+        // Prendre avec le roi n'est possible que si l'adversaire n'a plus rien pour reprendre
+        if (type == PieceType::King)
+            return (attackers & board.occupancy(~stm)) ? !result : result;
+
+        swap = pieceValue(type) - swap;
+        if (swap < static_cast<int>(result))
+            break;
+
+        occupied ^= squareBB(lsb(bb));
+        if (type == PieceType::Pawn || type == PieceType::Bishop || type == PieceType::Queen)
+            attackers |= Attacks::bishop(to, occupied) & diagonals;
+        if (type == PieceType::Rook || type == PieceType::Queen)
+            attackers |= Attacks::rook(to, occupied) & lines;
+    }
+
+    return result;
+}
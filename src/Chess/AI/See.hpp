@@ -0,0 +1,7 @@
+#pragma once
+#include "../Core/BoardState.hpp"
+#include "../Core/Move.hpp"
+
+// Échange statique (SEE) : la suite de prises sur la case d'arrivée, chaque camp prenant avec sa pièce la moins chère,
+// rapporte-t-elle au moins threshold ? Rayons X compris, rien d'alloué : tout se fait sur des bitboards.
+bool seeGE(const BoardState& board, Move move, int threshold = 0);
@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief File sans verrou à un producteur et un consommateur (tampon circulaire).
+ *
+ * push() et pop() se terminent toujours en un nombre borné d'instructions (wait-free) : le thread de recherche
+ * n'attend jamais l'affichage, et la boucle d'affichage ne bloque jamais sur la recherche.
+ * Chaque côté garde une copie de l'indice de l'autre et ne relit l'atomique que quand la file semble pleine / vide.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "la capacité doit être une puissance de 2");
+
+public:
+    // Côté producteur ; false si la file est pleine (l'élément n'est pas ajouté)
+    bool push(const T& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == Capacity)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == Capacity)
+                return false;
+        }
+        m_slots[tail & (Capacity - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Côté consommateur ; false si la file est vide
+    bool pop(T& value)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+                return false;
+        }
+        value = m_slots[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // Indices sur des lignes de cache séparées : chaque côté n'écrit que dans la sienne
+    alignas(64) std::atomic<size_t> m_head{0}; // écrit par le consommateur
+    size_t m_cachedTail = 0;
+    alignas(64) std::atomic<size_t> m_tail{0}; // écrit par le producteur
+    size_t m_cachedHead = 0;
+    alignas(64) std::array<T, Capacity> m_slots{};
+};
@@ -0,0 +1,60 @@
+#include "TimeManager.hpp"
+#include <algorithm>
+#include "Search.hpp"
+
+void TimeManager::start(const SearchLimits& limits, PieceColor us)
+{
+    m_start       = std::chrono::steady_clock::now();
+    m_softMs      = 0;
+    m_hardMs      = 0;
+    m_instability = 0.0;
+    m_fixed       = limits.movetimeMs > 0;
+
+    // Temps fixe par coup : on le prend en entier, sans viser plus court
+    if (m_fixed)
+    {
+        m_hardMs = std::max<int64_t>(limits.movetimeMs - limits.moveOverheadMs, 1);
+        m_softMs = m_hardMs;
+        return;
+    }
+
+    const int64_t remaining = limits.timeMs[colorIndex(us)];
+    if (remaining <= 0)
+        return;
+
+    // La marge (affichage, réseau, latence du thread) est retirée d'office : le reste est tout ce qu'on peut dépenser
+    const int64_t increment = limits.incrementMs[colorIndex(us)];
+    const int64_t available = std::max<int64_t>(remaining - limits.moveOverheadMs, 1);
+    const int64_t movesToGo = limits.movesToGo > 0 ? std::min(limits.movesToGo, 50) : 40;
+
+    m_softMs = available / movesToGo + increment * 3 / 4;
+    // Jamais plus de 5 fois la cible, ni plus de 80 % de ce qui reste (il faudra encore jouer les coups suivants)
+    m_hardMs = std::min(m_softMs * 5, available * 4 / 5);
+    if (limits.movesToGo == 1)
+        m_hardMs = available; // dernier coup avant le contrôle : on peut tout utiliser
+    m_hardMs = std::max<int64_t>(m_hardMs, 1);
+    m_softMs = std::clamp<int64_t>(m_softMs, 1, m_hardMs);
+}
+
+bool TimeManager::stopAfterIteration(bool bestMoveChanged)
+{
+    if (!enabled() || m_fixed)
+        return false;
+
+    // Un meilleur coup instable vaut qu'on cherche plus longtemps ; l'effet s'estompe de moitié à chaque itération
+    m_instability = m_instability / 2 + (bestMoveChanged ? 1.0 : 0.0);
+    return softLimitReached();
+}
+
+bool TimeManager::softLimitReached() const
+{
+    if (!enabled() || m_fixed)
+        return false;
+
+    const double target  = static_cast<double>(m_softMs) * std::min(1.0 + m_instability, 2.5);
+    const double elapsed = static_cast<double>(elapsedMs());
+
+    // L'itération suivante coûte à peu près autant que toutes les précédentes réunies :
+    // passé 60 % du budget, elle serait presque sûrement coupée par la limite dure, en pure perte
+    return elapsed >= std::min(target, static_cast<double>(m_hardMs)) * 0.6;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include "../Core/Bitboard.hpp"
+
+struct SearchLimits;
+
+/**
+ * @brief Répartition du temps de réflexion d'un coup.
+ *
+ * Deux bornes : la limite "souple" est le temps qu'on vise (on ne commence pas d'itération qu'on n'aura pas le temps
+ * de finir, et on la dépasse quand le meilleur coup change d'une itération à l'autre) ; la limite "dure" coupe la
+ * recherche en plein milieu, quoi qu'il arrive, pour ne jamais perdre au temps.
+ */
+class TimeManager {
+public:
+    // Démarre le chronomètre et calcule les deux bornes pour le camp au trait ; sans contrôle du temps, aucune borne
+    void start(const SearchLimits& limits, PieceColor us);
+
+    bool    enabled() const { return m_hardMs > 0; }
+    int64_t softMs() const { return m_softMs; }
+    int64_t hardMs() const { return m_hardMs; }
+
+    int64_t elapsedMs() const
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start).count();
+    }
+    int64_t elapsedUs() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    bool hardLimitReached() const { return m_hardMs > 0 && elapsedMs() >= m_hardMs; }
+
+    // Le budget souple (étiré par l'instabilité du meilleur coup) est-il déjà assez entamé pour ne plus rien commencer ?
+    bool softLimitReached() const;
+
+    // Appelé à la fin de chaque itération : faut-il s'arrêter là ?
+    // bestMoveChanged : le meilleur coup n'est plus celui de l'itération précédente
+    bool stopAfterIteration(bool bestMoveChanged);
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+    int64_t                               m_softMs      = 0;
+    int64_t                               m_hardMs      = 0;
+    double                                m_instability = 0.0; // changements récents du meilleur coup, amortis
+    bool                                  m_fixed       = false; // temps fixe par coup : seule la limite dure compte
+};
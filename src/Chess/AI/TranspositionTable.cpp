@@ -0,0 +1,199 @@
+#include "TranspositionTable.hpp"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+#include "Search.hpp"
+
+#if defined(_WIN32)
+    #include <malloc.h>
+#elif defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+namespace {
+
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+void* allocateLarge(size_t bytes)
+{
+    // Alignement sur une grande page dès que la table en occupe au moins une
+    const size_t alignment = bytes >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : 64;
+    bytes                  = (bytes + alignment - 1) / alignment * alignment;
+#if defined(_WIN32)
+    return _aligned_malloc(bytes, alignment);
+#else
+    void* memory = std::aligned_alloc(alignment, bytes);
+    #if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (memory && alignment == HUGE_PAGE_SIZE)
+        madvise(memory, bytes, MADV_HUGEPAGE); // simple conseil au noyau : un échec n'a pas de conséquence
+    #endif
+    return memory;
+#endif
+}
+
+void freeLarge(void* memory)
+{
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+// Âge relatif d'une entrée, en tenant compte du retour à zéro du compteur de recherches
+int relativeAge(uint8_t generation, uint8_t entryGeneration)
+{
+    return (generation - entryGeneration) & 0x3F;
+}
+
+int entryDepth(uint64_t data) { return static_cast<uint8_t>(data >> 32); }
+uint8_t entryGeneration(uint64_t data) { return static_cast<uint8_t>((data >> 42) & 0x3F); }
+
+} // namespace
+
+TranspositionTable::~TranspositionTable()
+{
+    freeLarge(m_clusters);
+}
+
+void TranspositionTable::resize(size_t megabytes)
+{
+    freeLarge(m_clusters);
+    m_clusters = nullptr;
+
+    // Nombre de clusters arrondi à la puissance de 2 inférieure pour indexer par masque
+    m_clusterCount = std::bit_floor(std::max<size_t>(megabytes * 1024 * 1024 / sizeof(Cluster), 1));
+    void* memory   = allocateLarge(m_clusterCount * sizeof(Cluster));
+    if (!memory)
+        throw std::bad_alloc();
+
+    m_clusters   = new (memory) Cluster[m_clusterCount];
+    m_mask       = m_clusterCount - 1;
+    m_generation = 0;
+}
+
+void TranspositionTable::clear(unsigned threads)
+{
+    const auto clearRange = [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            for (Entry& entry : m_clusters[i].entries)
+            {
+                entry.check.store(0, std::memory_order_relaxed);
+                entry.data.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    const size_t             parts = std::clamp<size_t>(threads, 1, m_clusterCount);
+    std::vector<std::thread> helpers;
+    for (size_t part = 1; part < parts; ++part)
+        helpers.emplace_back(clearRange, m_clusterCount * part / parts, m_clusterCount * (part + 1) / parts);
+    clearRange(0, m_clusterCount / parts);
+    for (std::thread& helper : helpers)
+        helper.join();
+    m_generation = 0;
+}
+
+uint64_t TranspositionTable::pack(Move move, int score, int depth, Bound bound, uint8_t generation)
+{
+    return static_cast<uint64_t>(move.raw())
+           | static_cast<uint64_t>(static_cast<uint16_t>(static_cast<int16_t>(score))) << 16
+           | static_cast<uint64_t>(static_cast<uint8_t>(std::clamp(depth, 0, 255))) << 32
+           | static_cast<uint64_t>(bound) << 40
+           | static_cast<uint64_t>(generation & GENERATION_MASK) << 42;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTData& out) const
+{
+    const Cluster& cluster = m_clusters[key & m_mask];
+    for (const Entry& entry : cluster.entries)
+    {
+        const uint64_t data  = entry.data.load(std::memory_order_relaxed);
+        const uint64_t check = entry.check.load(std::memory_order_relaxed);
+        if ((check ^ data) != key || data == 0)
+            continue;
+
+        out.move  = Move::fromRaw(static_cast<uint16_t>(data));
+        out.score = static_cast<int16_t>(static_cast<uint16_t>(data >> 16));
+        out.depth = entryDepth(data);
+        out.bound = static_cast<Bound>((data >> 40) & 3);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, Move move, int score, int depth, Bound bound)
+{
+    Cluster& cluster = m_clusters[key & m_mask];
+
+    // Même position déjà présente : on la met à jour, sinon on sacrifie l'entrée la moins utile
+    // (la plus vieille, puis la moins profonde : 8 demi-coups de profondeur valent une recherche d'écart)
+    Entry*   replace     = &cluster.entries[0];
+    uint64_t replaceData = replace->data.load(std::memory_order_relaxed);
+    int      worstValue  = INT_MAX;
+    for (Entry& entry : cluster.entries)
+    {
+        const uint64_t data  = entry.data.load(std::memory_order_relaxed);
+        const uint64_t check = entry.check.load(std::memory_order_relaxed);
+        if ((check ^ data) == key && data != 0)
+        {
+            replace     = &entry;
+            replaceData = data;
+            break;
+        }
+
+        const int value = data == 0 ? INT_MIN : entryDepth(data) - 8 * relativeAge(m_generation, entryGeneration(data));
+        if (value < worstValue)
+        {
+            worstValue  = value;
+            replace     = &entry;
+            replaceData = data;
+        }
+    }
+
+    const bool sameKey = ((replace->check.load(std::memory_order_relaxed) ^ replaceData) == key) && replaceData != 0;
+    if (sameKey)
+    {
+        // On ne jette pas une analyse plus profonde de la même position pour un résultat approximatif
+        if (bound != BOUND_EXACT && depth + 4 <= entryDepth(replaceData) && entryGeneration(replaceData) == m_generation)
+            return;
+        // Garder l'ancien coup si le nouveau résultat n'en a pas
+        if (!move)
+            move = Move::fromRaw(static_cast<uint16_t>(replaceData));
+    }
+
+    const uint64_t data = pack(move, score, depth, bound, m_generation);
+    replace->data.store(data, std::memory_order_relaxed);
+    replace->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const
+{
+    const size_t clusters = std::min<size_t>(1000 / CLUSTER_SIZE, m_clusterCount);
+    int          used     = 0;
+    for (size_t i = 0; i < clusters; ++i)
+    {
+        for (const Entry& entry : m_clusters[i].entries)
+        {
+            const uint64_t data = entry.data.load(std::memory_order_relaxed);
+            if (data != 0 && entryGeneration(data) == m_generation)
+                ++used;
+        }
+    }
+    return static_cast<int>(used * 1000 / (clusters * CLUSTER_SIZE));
+}
+
+int scoreToTT(int score, int ply)
+{
+    return score >= VALUE_MATE_IN_MAX_PLY ? score + ply : score <= VALUE_MATED_IN_MAX_PLY ? score - ply : score;
+}
+
+int scoreFromTT(int score, int ply)
+{
+    return score >= VALUE_MATE_IN_MAX_PLY ? score - ply : score <= VALUE_MATED_IN_MAX_PLY ? score + ply : score;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "../Core/Move.hpp"
+
+enum Bound : uint8_t {
+    BOUND_NONE  = 0,
+    BOUND_UPPER = 1, // score <= valeur stockée (aucun coup n'a dépassé alpha)
+    BOUND_LOWER = 2, // score >= valeur stockée (coupure bêta)
+    BOUND_EXACT = BOUND_UPPER | BOUND_LOWER,
+};
+
+struct TTData {
+    Move  move  = Move::none();
+    int   score = 0;
+    int   depth = 0;
+    Bound bound = BOUND_NONE;
+};
+
+/**
+ * @brief Table de transposition partagée par tous les threads de recherche, sans verrou.
+ *
+ * La table est un tableau de "clusters" de 64 octets (une ligne de cache) contenant 4 entrées.
+ * Chaque entrée garde clé ^ donnée et la donnée : une écriture concurrente "déchirée" ne passe pas la vérification,
+ * et le pire qui puisse arriver est de perdre une entrée.
+ * Quand le cluster est plein, on remplace l'entrée la moins utile : faible profondeur et ancienne recherche.
+ * La mémoire est alignée sur 2 Mo et, sous Linux, marquée MADV_HUGEPAGE : avec des pages de 4 Ko,
+ * une table de plusieurs Go passe son temps en défauts de TLB.
+ */
+class TranspositionTable {
+public:
+    explicit TranspositionTable(size_t megabytes = 16) { resize(megabytes); }
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable&)            = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    void   resize(size_t megabytes);
+    size_t sizeMegabytes() const { return m_clusterCount * sizeof(Cluster) / (1024 * 1024); }
+    // Remet toutes les entrées à zéro ; O(taille) : avec plusieurs threads, chacun en efface une tranche
+    void clear(unsigned threads = 1);
+
+    // À appeler au début de chaque recherche : les entrées des recherches précédentes vieillissent
+    void newSearch() { m_generation = (m_generation + 1) & GENERATION_MASK; }
+
+    bool probe(uint64_t key, TTData& data) const;
+    void store(uint64_t key, Move move, int score, int depth, Bound bound);
+
+    // Demande au processeur de charger le cluster de cette clé, avant d'en avoir besoin
+    void prefetch(uint64_t key) const
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(&m_clusters[key & m_mask]);
+#endif
+    }
+
+    // Taux de remplissage en pour mille (entrées de la recherche courante), estimé sur les 1000 premières entrées
+    int hashfull() const;
+
+private:
+    static constexpr int CLUSTER_SIZE    = 4;
+    static constexpr int GENERATION_MASK = 0x3F; // 6 bits d'âge
+
+    struct Entry {
+        std::atomic<uint64_t> check{0}; // clé ^ donnée
+        std::atomic<uint64_t> data{0};  // coup | score << 16 | profondeur << 32 | borne << 40 | âge << 42
+    };
+
+    struct alignas(64) Cluster {
+        Entry entries[CLUSTER_SIZE];
+    };
+    static_assert(sizeof(Cluster) == 64, "un cluster doit tenir dans une ligne de cache");
+
+    static uint64_t pack(Move move, int score, int depth, Bound bound, uint8_t generation);
+
+    Cluster* m_clusters     = nullptr;
+    size_t   m_clusterCount = 0;
+    uint64_t m_mask         = 0;
+    uint8_t  m_generation   = 0;
+};
+
+// Les scores de mat sont relatifs à la racine dans la recherche, mais à la position dans la table
+int scoreToTT(int score, int ply);
+int scoreFromTT(int score, int ply);
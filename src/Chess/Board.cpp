@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include "../3Dengine/Renderer3D.hpp"
+#include "Core/MoveGen.hpp"
 #include "GameMode/ClassicChess.hpp"
 #include "GameMode/DrunkChess.hpp"
 
@@ -18,7 +19,7 @@ void Board::setGameMode(std::unique_ptr<GameMode> mode)
 {
     m_currentGameMode = std::move(mode);
     m_gameOver        = false;
-    m_turn            = PieceColor::White;
+    m_isDraw          = false;
 }
 
 void Board::initializeBoard(Renderer3D* renderer)
@@ -29,31 +30,66 @@ void Board::initializeBoard(Renderer3D* renderer)
     // on délègue l'initialisation à la classe de mode de jeu actuelle
     if (m_currentGameMode)
     {
-        m_currentGameMode->initializeBoard(m_list);
+        m_currentGameMode->initializeBoard(m_state);
     }
-    m_lastDoublePawnMove.reset();
-    m_renderer3D->updatePiecesFromBoard(*this);
+    m_startState = m_state;
+    m_moves.clear();
+    refreshRenderer();
 }
 
-//getter pour le vector
-Piece Board::get(Position pos) const
+// Le rendu ne suit la position qu'une fois par coup joué, jamais pendant les calculs sur m_state
+void Board::refreshRenderer()
 {
-    return m_list.at(pos.x + pos.y * 8);
+    if (m_renderer3D)
+    {
+        m_renderer3D->updatePiecesFromBoard(*this);
+    }
 }
 
-//Setter pour le vector
-void Board::set(Position pos, Piece piece)
+FenError Board::loadFen(std::string_view fen)
+{
+    BoardState state;
+    if (FenError error = parseFen(state, fen); error != FenError::None)
+        return error;
+
+    m_state               = state;
+    m_startState          = state;
+    m_moves.clear();
+    m_gameOver            = false;
+    m_isDraw              = false;
+    m_selectedPiece       = std::nullopt;
+    m_promotionInProgress = false;
+    checkGameEnd(); // la FEN peut très bien décrire un mat ou un pat
+    refreshRenderer();
+    return FenError::None;
+}
+
+GameResult Board::result() const
+{
+    if (!m_gameOver)
+        return GameResult::Unknown;
+    if (m_isDraw)
+        return GameResult::Draw;
+    return m_winner == PieceColor::White ? GameResult::WhiteWins : GameResult::BlackWins;
+}
+
+bool Board::savePgn(std::FILE* file, const PgnTag* tags, int tagCount) const
 {
-    m_list.at(pos.x + pos.y * 8) = piece;
+    PgnWriter writer(file);
+    writer.writeGame(tags, tagCount, m_startState, m_moves.data(), m_moves.size(), result());
+    return writer.flush();
 }
 
-//Méthode pour déplacer une pièce dans le vector
-void Board::move(Position from, Position to)
+//getter pour une case
+Piece Board::get(Position pos) const
 {
-    set(to, get(from));
-    set(from, {PieceType::None, PieceColor::White});
+    return m_state.get(pos);
+}
 
-    m_renderer3D->updatePiecesFromBoard(*this);
+//Setter pour une case
+void Board::set(Position pos, Piece piece)
+{
+    m_state.set(pos, piece);
 }
 
 ImVec4 Board::getPieceColor(Piece piece) const
@@ -76,7 +112,10 @@ void Board::drawBoard()
         ImGui::SetCursorPosX(ImGui::GetCursorPosX() + leftPadding);
     }
 
-    for (int i = 0; i < m_list.size(); ++i)
+    // Les cibles de la pièce sélectionnée sont calculées une seule fois pour tout le plateau
+    Bitboard targets = m_selectedPiece ? getValidTargets(*m_selectedPiece) : 0;
+
+    for (int i = 0; i < 64; ++i)
     {
         if (i % 8 == 0)
         {
@@ -108,7 +147,7 @@ void Board::drawBoard()
         ImGui::PushStyleColor(ImGuiCol_Button, tileColor);
         
         // Récupération de la pièce
-        Piece       piece      = m_list.at(i);
+        Piece       piece      = m_state.get(i);
         std::string label      = std::string(1, piece.toChar());
         ImVec4      pieceColor = getPieceColor(piece);
         
@@ -130,34 +169,24 @@ void Board::drawBoard()
         // Dessiner les effets spécifiques au mode
         m_currentGameMode->drawTileEffect(pos, cursorPos, piece);
         
-        drawPossibleMoves(pos, cursorPos, tileSize);
+        drawPossibleMoves(pos, cursorPos, tileSize, targets);
     }
 
     ImGui::PopStyleVar();
     handlePawnPromotion();
 }
 
-void Board::drawPossibleMoves(Position pos, ImVec2 cursorPos, float tileSize)
+void Board::drawPossibleMoves(Position pos, ImVec2 cursorPos, float tileSize, Bitboard targets)
 {
-    if (!m_selectedPiece)
-        return;
-
-    Piece selectedPiece = get(*m_selectedPiece);
-    if (selectedPiece.type == PieceType::None)
-        return;
-
-    for (const Position& move : getValidMoves(*m_selectedPiece))
+    if (targets & squareBB(squareOf(pos)))
     {
-        if (move.x == pos.x && move.y == pos.y)
-        {
-            float circleRadius = tileSize / 5;
-            
-            ImGui::GetWindowDrawList()->AddCircleFilled(
-                ImVec2(cursorPos.x + tileSize / 2, cursorPos.y + tileSize / 2), // Centre du cercle
-                circleRadius,                                             
-                IM_COL32(0, 255, 0, 150)                                  // Vert
-            );
-        }
+        float circleRadius = tileSize / 5;
+
+        ImGui::GetWindowDrawList()->AddCircleFilled(
+            ImVec2(cursorPos.x + tileSize / 2, cursorPos.y + tileSize / 2), // Centre du cercle
+            circleRadius,                                             
+            IM_COL32(0, 255, 0, 150)                                  // Vert
+        );
     }
 }
 
@@ -175,7 +204,7 @@ void Board::handleMouseInteraction(int index)
 
 void Board::handleClick(Position pos)
 {
-    if (m_promotionInProgress)
+    if (m_promotionInProgress || !m_interactive)
         return;
 
     Piece piece = get(pos);
@@ -189,7 +218,7 @@ void Board::handleClick(Position pos)
     {
         Position from = *m_selectedPiece;
         // Si on clique sur une pièce du même joueur -> on sélectionne celle-ci à la place
-        if (piece.type != PieceType::None && ((m_turn == PieceColor::White && piece.color == PieceColor::White) || (m_turn == PieceColor::Black && piece.color == PieceColor::Black)))
+        if (piece.type != PieceType::None && piece.color == m_state.sideToMove())
         {
             selectPiece(pos);
         }
@@ -206,7 +235,7 @@ void Board::selectPiece(Position pos)
     Piece selectedPiece = get(pos);
 
     // Vérifier que la pièce appartient au joueur actif
-    if (selectedPiece.type != PieceType::None && selectedPiece.color == m_turn)
+    if (selectedPiece.type != PieceType::None && selectedPiece.color == m_state.sideToMove())
     {
         m_selectedPiece = pos;
         // la cam sur la pièce sélectionnée
@@ -231,74 +260,6 @@ void Board::syncCameraWithSelection()
     }
 }
 
-//Vérifier si une pièce bloque le passage
-bool Board::isPathClear(Position from, Position to) const
-{
-    int dx = to.x - from.x;
-    int dy = to.y - from.y;
-
-    int stepX = (dx == 0) ? 0 : (dx > 0 ? 1 : -1);
-    int stepY = (dy == 0) ? 0 : (dy > 0 ? 1 : -1);
-
-    Position checkPos = from;
-    checkPos.x += stepX;
-    checkPos.y += stepY;
-
-    while (checkPos.x != to.x || checkPos.y != to.y)
-    {
-        if (!checkPos.isValid() || get(checkPos).type != PieceType::None)
-        {
-            return false; // Une pièce bloque le passage
-        }
-        checkPos.x += stepX;
-        checkPos.y += stepY;
-    }
-
-    return true;
-}
-
-bool Board::isEnPassantCapture(Position from, Position to) const
-{
-    if (!m_lastDoublePawnMove)
-        return false;
-
-    Piece piece = get(from);
-
-    // Vérifier si c'est un pion
-    if (piece.type != PieceType::Pawn)
-        return false;
-
-    // Vérifier si le mouvement est une capture en diagonale
-    int dx        = to.x - from.x;
-    int dy        = to.y - from.y;
-    int direction = (piece.color == PieceColor::White) ? 1 : -1;
-
-    if (abs(dx) != 1 || dy != direction)
-        return false;
-
-    // Vérifier si la position cible est directement derrière le pion qui a fait un double mouvement
-    Position pawnPos   = *m_lastDoublePawnMove;
-    int      expectedY = (piece.color == PieceColor::White) ? 4 : 3; // Le pion capturé doit être sur la 5e ou 4e rangée
-
-    return to.x == pawnPos.x && from.y == expectedY && pawnPos.y == from.y;
-}
-
-bool Board::isPawnPromotion(Position from, Position to, Piece piece) const
-{
-    if (piece.type != PieceType::Pawn)
-        return false;
-
-    // Un pion blanc qui atteint la rangée 7
-    if (piece.color == PieceColor::White && to.y == 7)
-        return true;
-
-    // Un pion noir qui atteint la rangée 0
-    if (piece.color == PieceColor::Black && to.y == 0)
-        return true;
-
-    return false;
-}
-
 bool Board::isGameOver() const
 {
     return m_gameOver;
@@ -309,138 +270,79 @@ void Board::movePiece(Position pos)
     if (!m_selectedPiece)
         return;
 
-    Position from        = *m_selectedPiece;
-    Piece    piece       = get(from);
-    Piece    targetPiece = get(pos);
-
-    // Vérifier d'abord si le mouvement est valide (selon les règles classico)
-    if (!m_currentGameMode->isValidMove(m_list, from, pos, piece))
+    // Le coup doit faire partie des coups légaux (roque, en passant et promotions compris)
+    Move move = findLegalMove(m_state, squareOf(*m_selectedPiece), squareOf(pos));
+    if (move)
     {
-        m_selectedPiece.reset();
-        return;
+        playMove(move, true);
     }
-        
-    bool isPawnDoubleMove = false;
 
-    //Maintenant, on vérifie les cas spécials
-    if (piece.type == PieceType::Pawn && abs(pos.x - from.x) == 1)
-    {
-        if (isEnPassantCapture(from, pos))
-        {
-            // Déterminer la position du pion à capturer
-            Position capturedPawnPos = {pos.x, from.y};
-            // Exécuter un mouvement en passant
-            move(from, pos);
-            set(capturedPawnPos, {PieceType::None, PieceColor::White});
-        }
-        // Capture normale: un pion ne peut se déplacer en diagonale que s'il y a une pièce ennemie à capturer
-        else if (targetPiece.type == PieceType::None)
-        {
-            m_selectedPiece.reset(); // Annuler la sélection
-            return;
-        }
-        else
-        {
-            // Déléguer au mode de jeu
-            m_currentGameMode->executeMove(m_list, from, pos);
-        }
-    }
-    else
-    {
-        // Déléguer au mode de jeu pour les autres types de mouvements
-        m_currentGameMode->executeMove(m_list, from, pos);
-    }
+    m_selectedPiece.reset(); 
+}
 
-    // Vérifier s'il s'agit d'un mouvement de deux cases pour un pion
-    if (piece.type == PieceType::Pawn)
-    {
-        int dy = pos.y - from.y;
-        if (abs(dy) == 2)
-        {
-            m_lastDoublePawnMove = pos;
-            isPawnDoubleMove = true;
-        }
-        else
-        {
-            m_lastDoublePawnMove.reset(); 
-        }
-    }
-    else
-    {
-        m_lastDoublePawnMove.reset();
-    }
+bool Board::playMove(Move move, bool choosePromotion)
+{
+    const Position   from  = positionOf(move.from());
+    const Position   to    = positionOf(move.to());
+    const PieceColor color = m_state.sideToMove();
 
-    m_renderer3D->updatePiecesFromBoard(*this);
+    if (m_gameOver || m_promotionInProgress || !m_currentGameMode->isValidMove(m_state, from, to, get(from)))
+        return false;
+
+    // Déléguer au mode de jeu (le mode bourré peut encore dévier le coup) ; l'historique garde le coup réellement joué
+    m_currentGameMode->executeMove(m_state, move);
+    m_moves.push_back(m_state.lastUndo().move);
 
-    if (targetPiece.type == PieceType::King){
+    // Un coup dévié peut encore "capturer" le roi adverse
+    if (m_state.pieces(~color, PieceType::King) == 0)
+    {
         m_gameOver = true;
-        m_winner = piece.color; 
+        m_winner = color; 
         m_promotionInProgress = false;
     }
 
-    // Gérer la promotion de pion seulement si le jeu n'est pas terminé
-    if (isPawnPromotion(from, pos, piece) && !m_gameOver)
+    // Gérer la promotion de pion seulement si le jeu n'est pas terminé (la dame posée par défaut peut être changée).
+    // On regarde le coup réellement joué : le mode bourré a pu changer la case d'arrivée.
+    if (choosePromotion && m_state.lastUndo().move.isPromotion() && !m_gameOver)
     {
         m_promotionInProgress = true;
-        m_promotionPosition   = pos;
-        m_promotionColor      = piece.color;
     }
     else if (!m_gameOver)
     {
         nextTurn();
     }
 
-    m_selectedPiece.reset(); 
+    refreshRenderer();
+    return true;
 }
 
-void Board::executeMove(Position from, Position to)
+void Board::nextTurn()
 {
-    Piece piece = get(from);
-    bool isEnPassant = isEnPassantCapture(from, to);
-    Position capturedPawnPos;
-
-    if (isEnPassant)
+    // Le trait a déjà été passé par BoardState::makeMove
+    if (m_currentGameMode)
     {
-        capturedPawnPos = {to.x, from.y}; // Le pion à capturer est sur la même rangée que notre pion
+        m_currentGameMode->updatePerTurn(m_state, m_state.sideToMove());
     }
 
-    // Exécuter le mouvement
-    move(from, to);
+    checkGameEnd();
+}
 
-    // Si c'était une capture en passant, enlever le pion capturé
-    if (isEnPassant)
-    {
-        set(capturedPawnPos, {PieceType::None, PieceColor::White});
-    }
+// Plus aucun coup légal : échec et mat si le roi est attaqué, pat sinon
+void Board::checkGameEnd()
+{
+    MoveList moves;
+    generateLegalMoves(m_state, moves);
+    if (!moves.empty())
+        return;
 
-    // Mettre à jour m_lastDoublePawnMove si c'était un double mouvement de pion
-    if (piece.type == PieceType::Pawn)
+    m_gameOver = true;
+    if (m_state.inCheck())
     {
-        int dy = to.y - from.y;
-        if (abs(dy) == 2)
-        {
-            m_lastDoublePawnMove = to;
-        }
-        else
-        {
-            m_lastDoublePawnMove.reset(); 
-        }
+        m_winner = ~m_state.sideToMove();
     }
     else
     {
-        m_lastDoublePawnMove.reset(); 
-    }
-
-    m_renderer3D->updatePiecesFromBoard(*this);
-}
-
-void Board::nextTurn()
-{
-    m_turn = (m_turn == PieceColor::White) ? PieceColor::Black : PieceColor::White;
-
-    if (m_currentGameMode)
-    {
-        m_currentGameMode->updatePerTurn(m_list, m_turn);
+        m_isDraw = true;
     }
 }
 
@@ -467,9 +369,13 @@ void Board::handlePawnPromotion()
         {
             if (ImGui::Button(name, ImVec2(100, 40)))
             {
-                set(m_promotionPosition, {type, m_promotionColor});
+                // On rejoue le même coup avec la pièce choisie, pour que la pile d'annulation reste juste
+                const Move played = m_state.lastUndo().move;
+                m_state.unmakeMove();
+                m_state.makeMove(Move(played.from(), played.to(), promotionFlag(type) | (played.flags() & Capture)));
+                m_moves.back() = m_state.lastUndo().move;
 
-                m_renderer3D->updatePiecesFromBoard(*this);
+                refreshRenderer();
 
                 m_promotionInProgress = false;
                 ImGui::CloseCurrentPopup();
@@ -491,96 +397,22 @@ void Board::handlePawnPromotion()
 }
 
 //Uniquement visuel
-//Pour avoir la liste des positions valides pour un mouvement
-std::vector<Position> Board::getValidMoves(Position from) const
+//Pour avoir l'ensemble des cases d'arrivée légales d'une pièce
+Bitboard Board::getValidTargets(Position from) const
 {
-    std::vector<Position> moves;
-    Piece                 piece = get(from);
-    if (piece.type == PieceType::None)
-        return moves;
+    MoveList moves;
+    generateLegalMoves(m_state, moves);
 
-    // Vérifier spécifiquement la capture en passant pour les pions
-    if (piece.type == PieceType::Pawn && m_lastDoublePawnMove)
+    Bitboard targets = 0;
+    int      sq      = squareOf(from);
+    for (Move move : moves)
     {
-        Position pawnPos   = *m_lastDoublePawnMove;
-        int      direction = (piece.color == PieceColor::White) ? 1 : -1;
-        int      expectedY = (piece.color == PieceColor::White) ? 4 : 3;
-
-        // Si le pion est adjacent au pion qui a fait un double mouvement et sur la bonne rangée
-        if (from.y == expectedY && abs(from.x - pawnPos.x) == 1 && pawnPos.y == from.y)
+        if (move.from() == sq)
         {
-            // Vérifier que c'est bien un pion ennemi
-            Piece possiblePawn = get(pawnPos);
-            if (possiblePawn.type == PieceType::Pawn && possiblePawn.color != piece.color)
-            {
-                // Ajouter la position de capture en passant
-                Position enPassantPos = {pawnPos.x, from.y + direction};
-                moves.push_back(enPassantPos);
-            }
-        }
-    }
-
-    // Ajouter le reste des mouvements valides comme avant
-    for (int x = 0; x < 8; ++x)
-    {
-        for (int y = 0; y < 8; ++y)
-        {
-            Position to = {x, y};
-
-            // Vérification spéciale pour les pions qui se déplacent en diagonale
-            if (piece.type == PieceType::Pawn && abs(to.x - from.x) == 1 )
-            {
-                int dy        = to.y - from.y;
-                int direction = (piece.color == PieceColor::White) ? 1 : -1;
-
-                // Vérifier que c'est bien un mouvement diagonal vers l'avant
-                if (dy != direction)
-                {
-                    continue;
-                }
-
-                Piece targetPiece = get(to);
-                // Un pion ne peut aller en diagonale que s'il y a une pièce ennemie
-                if (targetPiece.type == PieceType::None)
-                {
-                    continue; // Pas de pièce à capturer, on ne peut pas aller en diagonale ici
-                }
-                else if (targetPiece.color == piece.color)
-                {
-                    continue; // Ne peut pas capturer sa propre couleur
-                }
-            }
-
-            //si il y a un ennemi devant un pion qui avance de deux cases
-            if (piece.type == PieceType::Pawn && abs(to.x - from.x) == 0 && abs(to.y - from.y) == 2)
-            {
-                Position middlePos = {from.x, from.y + ((piece.color == PieceColor::White) ? 1 : -1)};
-                Piece    middlePiece = get(middlePos);
-                if (middlePiece.type != PieceType::None)
-                {
-                    continue; // Une pièce bloque le passage
-                }
-            }
-
-            if (!piece.isMoveValid(from, to))
-                continue;
-
-            Piece targetPiece = get(to);
-
-            // Vérifier les obstacles pour la Tour, le Fou et la Reine
-            if ((piece.type == PieceType::Rook || piece.type == PieceType::Bishop || piece.type == PieceType::Queen) && !isPathClear(from, to))
-            {
-                continue; // Bloqué par une autre pièce
-            }
-
-            // Empêcher de se déplacer sur une pièce alliée
-            if (targetPiece.type == PieceType::None || targetPiece.color != piece.color)
-            {
-                moves.push_back(to);
-            }
+            targets |= squareBB(move.to());
         }
     }
-    return moves;
+    return targets;
 }
 
 std::string Board::getCurrentModeName() const
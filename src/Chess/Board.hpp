@@ -6,6 +6,9 @@
 #include "Piece.hpp"
 #include "Position.hpp"
 #include "GameMode/GameMode.hpp" 
+#include "Core/BoardState.hpp"
+#include "Core/Fen.hpp"
+#include "Core/Pgn.hpp"
 #include <memory> 
 
 
@@ -18,14 +21,33 @@ public:
     void initializeBoard(Renderer3D* renderer = nullptr);
     Piece      get(Position pos) const;
     void       set(Position pos, Piece piece);
-    void       move(Position from, Position to);
-    void       executeMove(Position from, Position to);
     void       drawBoard();
+
+    // Côté règles uniquement (aucune sélection ImGui) : joue un coup légal, gère fin de partie et promotion,
+    // puis rafraîchit le rendu une seule fois. Renvoie false si le mode de jeu refuse le coup.
+    // Avec choosePromotion, une promotion ouvre la fenêtre de choix (joueur humain) au lieu de garder la pièce du coup.
+    bool       playMove(Move move, bool choosePromotion = false);
+    bool       isPromotionPending() const { return m_promotionInProgress; }
+
+    // Remplace la position par celle de la FEN (partie reprise en cours) ; en cas d'erreur la position ne change pas
+    FenError   loadFen(std::string_view fen);
+
+    // Historique de la partie : position de départ (initiale ou FEN chargée) et coups joués depuis, 2 octets par coup
+    const BoardState&        startState() const { return m_startState; }
+    const std::vector<Move>& moveHistory() const { return m_moves; }
+    GameResult               result() const;
+    // Écrit la partie en PGN (tags Event, Date, White, Black fournis par l'appelant) ; false si l'écriture échoue
+    bool                     savePgn(std::FILE* file, const PgnTag* tags, int tagCount) const;
+
+    // Quand c'est à l'ordinateur de jouer, les clics sur le plateau sont ignorés
+    void       setInteractive(bool interactive) { m_interactive = interactive; }
     bool       isGameOver() const;
+    bool       isDraw() const { return m_isDraw; }
     PieceColor getWinner() const;
     
-    //Pour le renderer3D
-    const std::vector<Piece>& getBoardState() const { return m_list; }
+    //Pour le renderer3D (vue générée à la demande depuis les bitboards)
+    std::vector<Piece> getBoardState() const { return m_state.toList(); }
+    const BoardState&  getState() const { return m_state; }
     void setRenderer3D(Renderer3D* renderer) { m_renderer3D = renderer; }
     void syncCameraWithSelection();
 
@@ -35,19 +57,19 @@ public:
     GameMode* getGameMode() const { return m_currentGameMode.get(); }
 
 private:
-    std::vector<Piece> m_list     = std::vector<Piece>(64);
-    PieceColor         m_turn     = PieceColor::White; 
+    BoardState         m_state;
+    BoardState         m_startState;
+    std::vector<Move>  m_moves;
     PieceColor         m_winner   = PieceColor::White; // Couleur du joueur gagnant
     bool               m_gameOver = false;
+    bool               m_isDraw   = false; // Pat
     Renderer3D*        m_renderer3D = nullptr; 
     std::unique_ptr<GameMode> m_currentGameMode; 
 
     std::optional<Position> m_selectedPiece;      
-    std::optional<Position> m_lastDoublePawnMove;
 
-    bool       m_promotionInProgress = false;
-    Position   m_promotionPosition;
-    PieceColor m_promotionColor;
+    bool       m_promotionInProgress = false; // le dernier coup joué est une promotion dont on attend le choix
+    bool       m_interactive         = true;
     
     void   drawTile(int index, bool pairLin, ImVec2& outCursorPos);
     ImVec4 getPieceColor(Piece piece) const;
@@ -57,13 +79,12 @@ private:
     void selectPiece(Position pos);
     void movePiece(Position pos);
     void nextTurn();
+    void checkGameEnd();
+    void refreshRenderer();
 
-    bool                  isPathClear(Position from, Position to) const;
-    bool                  isEnPassantCapture(Position from, Position to) const;
-    std::vector<Position> getValidMoves(Position from) const;
+    Bitboard getValidTargets(Position from) const;
 
-    void drawPossibleMoves(Position pos, ImVec2 cursorPos, float tileSize);
+    void drawPossibleMoves(Position pos, ImVec2 cursorPos, float tileSize, Bitboard targets);
 
     void handlePawnPromotion();
-    bool isPawnPromotion(Position from, Position to, Piece piece) const;
 };
\ No newline at end of file
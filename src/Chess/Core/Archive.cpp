@@ -0,0 +1,331 @@
+#include "Archive.hpp"
+#include <cstring>
+#include "Bytes.hpp"
+#include "Fen.hpp"
+#include "MoveGen.hpp"
+
+namespace {
+
+using namespace Bytes;
+
+constexpr size_t  HEADER_SIZE      = 40; // magic, version, réservé, nombre de parties, chaînes, index
+constexpr size_t  INDEX_ENTRY_SIZE = 16;
+constexpr size_t  WRITE_THRESHOLD  = 1 << 20;
+constexpr uint8_t FLAG_FEN         = 1;
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// nullptr si le varint déborde de [in, end)
+const uint8_t* getVarint(const uint8_t* in, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; in < end && shift < 64; shift += 7)
+    {
+        const uint8_t byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return in;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// --- Écriture ---
+
+bool ArchiveWriter::open(const std::string& path)
+{
+    close();
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file)
+        return false;
+
+    // En-tête à zéro tant que l'archive n'est pas terminée : un fichier interrompu n'est pas lisible
+    m_ok      = true;
+    m_written = 0;
+    m_index.clear();
+    m_stringIds.clear();
+    m_strings.clear();
+    m_buffer.assign(HEADER_SIZE, 0);
+    m_buffer.reserve(WRITE_THRESHOLD + 4096);
+    return true;
+}
+
+uint32_t ArchiveWriter::stringId(std::string_view text)
+{
+    const auto [it, inserted] = m_stringIds.try_emplace(std::string(text), static_cast<uint32_t>(m_strings.size()));
+    if (inserted)
+        m_strings.push_back(it->first);
+    return it->second;
+}
+
+void ArchiveWriter::flushBuffer()
+{
+    if (!m_buffer.empty() && std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size())
+        m_ok = false;
+    m_written += m_buffer.size();
+    m_buffer.clear();
+}
+
+bool ArchiveWriter::addGame(const PgnTag* tags, int tagCount, const BoardState& start, const Move* moves, size_t moveCount, GameResult result)
+{
+    if (!m_file || moveCount > UINT16_MAX)
+        return false;
+
+    const size_t begin = m_buffer.size();
+    int          kept  = 0;
+    for (int i = 0; i < tagCount; ++i)
+        kept += tags[i].name != "Result" && tags[i].name != "SetUp" && tags[i].name != "FEN";
+    putVarint(m_buffer, static_cast<uint64_t>(kept));
+    for (int i = 0; i < tagCount; ++i)
+    {
+        if (tags[i].name == "Result" || tags[i].name == "SetUp" || tags[i].name == "FEN")
+            continue;
+        putVarint(m_buffer, stringId(tags[i].name));
+        putVarint(m_buffer, stringId(tags[i].value));
+    }
+
+    uint8_t flags = 0;
+    char    fen[FEN_MAX_LENGTH];
+    const std::string_view startFen(fen, writeFen(start, fen));
+    if (startFen != START_FEN)
+    {
+        flags |= FLAG_FEN;
+        m_buffer.push_back(static_cast<uint8_t>(startFen.size()));
+        m_buffer.insert(m_buffer.end(), startFen.begin(), startFen.end());
+    }
+
+    // Un octet par coup : son rang parmi les coups légaux (218 au plus)
+    m_board = start;
+    MoveList legal;
+    for (size_t i = 0; i < moveCount; ++i)
+    {
+        generateLegalMoves(m_board, legal);
+        size_t index = 0;
+        while (index < legal.size() && legal[index] != moves[i])
+            ++index;
+        if (index == legal.size())
+        {
+            m_buffer.resize(begin); // partie refusée : rien n'en reste
+            return false;
+        }
+        m_buffer.push_back(static_cast<uint8_t>(index));
+        m_board.makeMove(moves[i]);
+    }
+
+    const size_t size = m_buffer.size() - begin;
+    m_index.push_back({m_written + begin, static_cast<uint32_t>(size), static_cast<uint16_t>(moveCount), static_cast<uint8_t>(result), flags});
+    if (m_buffer.size() >= WRITE_THRESHOLD)
+        flushBuffer();
+    return true;
+}
+
+bool ArchiveWriter::close()
+{
+    if (!m_file)
+        return m_ok;
+
+    // Table de chaînes
+    const uint64_t stringsOffset = m_written + m_buffer.size();
+    putVarint(m_buffer, m_strings.size());
+    for (std::string_view text : m_strings)
+    {
+        putVarint(m_buffer, text.size());
+        m_buffer.insert(m_buffer.end(), text.begin(), text.end());
+        if (m_buffer.size() >= WRITE_THRESHOLD)
+            flushBuffer();
+    }
+
+    // Index : taille fixe, la partie i est à indexOffset + 16 * i
+    const uint64_t indexOffset = m_written + m_buffer.size();
+    for (const IndexEntry& entry : m_index)
+    {
+        uint8_t bytes[INDEX_ENTRY_SIZE];
+        put64(bytes, entry.offset);
+        put32(bytes + 8, entry.size);
+        put16(bytes + 12, entry.moveCount);
+        bytes[14] = entry.result;
+        bytes[15] = entry.flags;
+        m_buffer.insert(m_buffer.end(), bytes, bytes + INDEX_ENTRY_SIZE);
+        if (m_buffer.size() >= WRITE_THRESHOLD)
+            flushBuffer();
+    }
+    flushBuffer();
+
+    uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, Archive::MAGIC, sizeof(Archive::MAGIC));
+    put32(header + 8, Archive::VERSION);
+    put64(header + 16, m_index.size());
+    put64(header + 24, stringsOffset);
+    put64(header + 32, indexOffset);
+    if (std::fseek(m_file, 0, SEEK_SET) != 0 || std::fwrite(header, 1, HEADER_SIZE, m_file) != HEADER_SIZE)
+        m_ok = false;
+    if (std::fclose(m_file) != 0)
+        m_ok = false;
+    m_file = nullptr;
+    return m_ok;
+}
+
+// --- Lecture ---
+
+bool ArchiveReader::open(const std::string& path)
+{
+    m_base      = nullptr;
+    m_gameCount = 0;
+    m_strings.clear();
+    if (!m_file.open(path) || m_file.size() < HEADER_SIZE)
+        return false;
+
+    const auto*    base = reinterpret_cast<const uint8_t*>(m_file.view().data());
+    const uint64_t size = m_file.size();
+    if (std::memcmp(base, Archive::MAGIC, sizeof(Archive::MAGIC)) != 0 || get32(base + 8) != Archive::VERSION)
+        return false;
+
+    const uint64_t gameCount     = get64(base + 16);
+    const uint64_t stringsOffset = get64(base + 24);
+    const uint64_t indexOffset   = get64(base + 32);
+    if (stringsOffset < HEADER_SIZE || stringsOffset > indexOffset || indexOffset > size
+        || gameCount > (size - indexOffset) / INDEX_ENTRY_SIZE)
+        return false;
+
+    // La table de chaînes est petite devant les parties : on la découpe une fois pour toutes
+    const uint8_t* pos   = base + stringsOffset;
+    const uint8_t* end   = base + indexOffset;
+    uint64_t       count = 0;
+    if (!(pos = getVarint(pos, end, count)) || count > static_cast<uint64_t>(end - pos))
+        return false;
+    m_strings.reserve(count);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        uint64_t length = 0;
+        if (!(pos = getVarint(pos, end, length)) || length > static_cast<uint64_t>(end - pos))
+            return false;
+        m_strings.emplace_back(reinterpret_cast<const char*>(pos), length);
+        pos += length;
+    }
+
+    parseFen(m_initial, START_FEN);
+    m_base      = base;
+    m_dataEnd   = stringsOffset;
+    m_gameCount = gameCount;
+    m_index     = base + indexOffset;
+    return true;
+}
+
+ArchiveReader::Entry ArchiveReader::entry(uint64_t game) const
+{
+    // Partie qui n'existe pas : comme une entrée abîmée
+    if (game >= m_gameCount)
+        return {};
+
+    const uint8_t* bytes  = m_index + game * INDEX_ENTRY_SIZE;
+    const uint64_t offset = get64(bytes);
+    const uint32_t size   = get32(bytes + 8);
+    const uint16_t moves  = get16(bytes + 12);
+
+    // Entrée incohérente : marquée invalide (data nul), replay la refusera
+    if (offset < HEADER_SIZE || offset > m_dataEnd || size > m_dataEnd - offset || moves > size)
+        return {};
+    const uint8_t* data = m_base + offset;
+    return {data, data + size - moves, data + size, bytes[14], bytes[15]};
+}
+
+size_t ArchiveReader::moveCount(uint64_t game) const
+{
+    const Entry e = entry(game);
+    return e.data ? static_cast<size_t>(e.end - e.moves) : 0;
+}
+
+GameResult ArchiveReader::result(uint64_t game) const
+{
+    if (game >= m_gameCount)
+        return GameResult::Unknown;
+    const uint8_t result = m_index[game * INDEX_ENTRY_SIZE + 14];
+    return result <= static_cast<uint8_t>(GameResult::Draw) ? static_cast<GameResult>(result) : GameResult::Unknown;
+}
+
+int ArchiveReader::tags(uint64_t game, PgnTag* out, int maxTags) const
+{
+    const Entry    e     = entry(game);
+    const uint8_t* pos   = e.data;
+    uint64_t       count = 0;
+    if (!e.data || !(pos = getVarint(pos, e.moves, count)))
+        return 0;
+
+    int written = 0;
+    for (uint64_t i = 0; i < count && written < maxTags; ++i)
+    {
+        uint64_t name = 0, value = 0;
+        if (!(pos = getVarint(pos, e.moves, name)) || !(pos = getVarint(pos, e.moves, value)))
+            break;
+        if (name < m_strings.size() && value < m_strings.size())
+            out[written++] = {m_strings[name], m_strings[value]};
+    }
+    return written;
+}
+
+std::string_view ArchiveReader::tag(uint64_t game, std::string_view name) const
+{
+    PgnTag    tags[PgnGame::MaxTags];
+    const int count = this->tags(game, tags, PgnGame::MaxTags);
+    for (int i = 0; i < count; ++i)
+    {
+        if (tags[i].name == name)
+            return tags[i].value;
+    }
+    return {};
+}
+
+bool ArchiveReader::replay(uint64_t game, BoardState& board, ReplayedGame& replay) const
+{
+    replay.moves.clear();
+    replay.result     = GameResult::Unknown;
+    replay.errorToken = {};
+    const Entry e = entry(game);
+    if (!e.data)
+        return false;
+    replay.result = result(game);
+
+    if (e.flags & FLAG_FEN)
+    {
+        // La FEN suit les tags : on les saute
+        const uint8_t* pos   = e.data;
+        uint64_t       count = 0;
+        if (!(pos = getVarint(pos, e.moves, count)))
+            return false;
+        for (uint64_t i = 0; i < 2 * count; ++i)
+        {
+            uint64_t id = 0;
+            if (!(pos = getVarint(pos, e.moves, id)))
+                return false;
+        }
+        if (pos >= e.moves || *pos > e.moves - pos - 1)
+            return false;
+        const std::string_view fen(reinterpret_cast<const char*>(pos + 1), *pos);
+        if (parseFen(replay.start, fen) != FenError::None)
+            return false;
+    }
+    else
+        replay.start = m_initial;
+
+    board = replay.start;
+    MoveList legal;
+    for (const uint8_t* pos = e.moves; pos < e.end; ++pos)
+    {
+        generateLegalMoves(board, legal);
+        if (*pos >= legal.size())
+            return false;
+        const Move move = legal[*pos];
+        replay.moves.push_back(move);
+        board.makeMove(move);
+    }
+    return true;
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "BoardState.hpp"
+#include "MappedFile.hpp"
+#include "Move.hpp"
+#include "Pgn.hpp"
+
+/*
+ * Archive de parties : un octet par coup (son rang dans la liste des coups légaux, toujours générée dans le même
+ * ordre), les tags dans une table de chaînes partagée, et un index de taille fixe pour aller droit à une partie.
+ *
+ *   en-tête   "CHESSARC", version, nombre de parties, position de la table de chaînes et de l'index
+ *   parties   pour chacune : nombre de tags, puis (nom, valeur) en numéros de chaîne (varint),
+ *             FEN de départ (si la partie ne part pas de la position initiale), puis les coups
+ *   chaînes   longueur (varint) + octets, dans l'ordre des numéros
+ *   index     16 octets par partie : position, taille, nombre de coups, résultat, drapeaux
+ *
+ * Tous les entiers sont en petit-boutiste. L'index et les chaînes sont écrits à la fin : l'écriture se fait en un
+ * seul passage, sans connaître le nombre de parties à l'avance.
+ */
+namespace Archive {
+
+inline constexpr char     MAGIC[8] = {'C', 'H', 'E', 'S', 'S', 'A', 'R', 'C'};
+inline constexpr uint32_t VERSION  = 1;
+
+} // namespace Archive
+
+class ArchiveWriter {
+public:
+    ArchiveWriter() = default;
+    ~ArchiveWriter() { close(); }
+
+    ArchiveWriter(const ArchiveWriter&)            = delete;
+    ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+    bool open(const std::string& path);
+
+    // Ajoute une partie ; false si un coup n'est pas légal (mode bourré) ou si elle dépasse 65535 demi-coups.
+    // Les tags FEN, SetUp et Result sont ignorés : ce sont start et result qui comptent.
+    bool addGame(const PgnTag* tags, int tagCount, const BoardState& start, const Move* moves, size_t moveCount, GameResult result);
+
+    // Écrit la table de chaînes et l'index, complète l'en-tête ; false si une écriture a échoué
+    bool close();
+
+    uint64_t gameCount() const { return m_index.size(); }
+
+private:
+    struct IndexEntry {
+        uint64_t offset;
+        uint32_t size;
+        uint16_t moveCount;
+        uint8_t  result;
+        uint8_t  flags;
+    };
+
+    uint32_t stringId(std::string_view text);
+    void     flushBuffer();
+
+    std::FILE*                                m_file = nullptr;
+    std::vector<uint8_t>                      m_buffer;      // pas encore écrit dans le fichier
+    uint64_t                                  m_written = 0; // octets déjà écrits : m_buffer commence là
+    bool                                      m_ok      = true;
+    std::vector<IndexEntry>                   m_index;
+    std::unordered_map<std::string, uint32_t> m_stringIds;
+    std::vector<std::string_view>             m_strings; // dans l'ordre des numéros, vues sur les clés de m_stringIds
+    BoardState                                m_board;
+};
+
+class ArchiveReader {
+public:
+    // false si le fichier n'existe pas ou n'est pas une archive complète
+    bool open(const std::string& path);
+
+    // Pour un numéro de partie hors de l'archive ou une entrée d'index abîmée : 0 coup, aucun tag, replay refusé
+    uint64_t   gameCount() const { return m_gameCount; }
+    size_t     moveCount(uint64_t game) const;
+    GameResult result(uint64_t game) const;
+
+    // Tags de la partie (vues dans le fichier) ; renvoie leur nombre, au plus maxTags
+    int              tags(uint64_t game, PgnTag* out, int maxTags) const;
+    std::string_view tag(uint64_t game, std::string_view name) const;
+
+    // Comme replayGame : position de départ, coups et résultat dans replay, board finit sur la position finale.
+    // Chaque octet est décodé avec le générateur de coups ; false si l'archive est abîmée.
+    bool replay(uint64_t game, BoardState& board, ReplayedGame& replay) const;
+
+    size_t fileSize() const { return m_file.size(); }
+
+private:
+    struct Entry {
+        const uint8_t* data   = nullptr; // tags, FEN éventuelle, puis les coups ; nul si l'entrée est invalide
+        const uint8_t* moves  = nullptr;
+        const uint8_t* end    = nullptr;
+        uint8_t        result = 0;
+        uint8_t        flags  = 0;
+    };
+
+    Entry entry(uint64_t game) const;
+
+    MappedFile                    m_file;
+    const uint8_t*                m_base      = nullptr;
+    uint64_t                      m_dataEnd   = 0; // début de la table de chaînes
+    uint64_t                      m_gameCount = 0;
+    const uint8_t*                m_index     = nullptr;
+    std::vector<std::string_view> m_strings;
+    BoardState                    m_initial; // position de départ, pour ne pas relire START_FEN à chaque partie
+};
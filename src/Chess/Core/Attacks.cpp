@@ -0,0 +1,181 @@
+#include "Attacks.hpp"
+
+namespace Attacks {
+
+std::array<Magic, 64>                    RookMagics;
+std::array<Magic, 64>                    BishopMagics;
+std::array<Bitboard, 64>                 KnightAttacks;
+std::array<Bitboard, 64>                 KingAttacks;
+std::array<std::array<Bitboard, 64>, 2>  PawnAttacks;
+std::array<std::array<Bitboard, 64>, 64> BetweenBB;
+std::array<std::array<Bitboard, 64>, 64> LineBB;
+
+namespace {
+
+// Nombre total d'entrées pour toutes les cases (tables "fancy magic")
+Bitboard RookTable[0x19000];
+Bitboard BishopTable[0x1480];
+
+// Petit générateur xorshift64* : déterministe pour que la recherche des magiques soit reproductible
+class MagicRng {
+public:
+    explicit MagicRng(uint64_t seed)
+        : m_state(seed) {}
+
+    uint64_t next()
+    {
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return m_state * 2685821657736338717ULL;
+    }
+
+    // Peu de bits à 1 : les bons candidats magiques sont "creux"
+    uint64_t sparse() { return next() & next() & next(); }
+
+private:
+    uint64_t m_state;
+};
+
+// Attaque d'une pièce glissante calculée à la main (rayon par rayon) : sert uniquement à remplir les tables
+Bitboard slidingAttack(PieceType type, int sq, Bitboard occupied)
+{
+    static constexpr int rookDirections[4][2]   = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    static constexpr int bishopDirections[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    const auto&          directions             = (type == PieceType::Rook) ? rookDirections : bishopDirections;
+
+    Bitboard result = 0;
+    for (const auto& dir : directions)
+    {
+        int x = fileOf(sq) + dir[0];
+        int y = rankOf(sq) + dir[1];
+        while (x >= 0 && x < 8 && y >= 0 && y < 8)
+        {
+            int target = makeSquare(x, y);
+            result |= squareBB(target);
+            if (occupied & squareBB(target))
+                break;
+            x += dir[0];
+            y += dir[1];
+        }
+    }
+    return result;
+}
+
+Bitboard stepAttacks(int sq, const int (*steps)[2], int count)
+{
+    Bitboard result = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        int x = fileOf(sq) + steps[i][0];
+        int y = rankOf(sq) + steps[i][1];
+        if (x >= 0 && x < 8 && y >= 0 && y < 8)
+            result |= squareBB(makeSquare(x, y));
+    }
+    return result;
+}
+
+void initMagics(PieceType type, Bitboard* table, std::array<Magic, 64>& magics)
+{
+    // Graines par rangée qui trouvent des magiques rapidement (valeurs classiques de Stockfish)
+    static constexpr uint64_t seeds[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+
+    static Bitboard occupancy[4096];
+    static Bitboard reference[4096];
+    int             size = 0;
+#if !CHESS_USE_PEXT
+    static int epoch[4096] = {};
+    int        attempt     = 0;
+#endif
+
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        // Les bords ne bloquent jamais rien d'utile : on les retire du masque
+        Bitboard edges = ((RANK_1_BB | RANK_8_BB) & ~rankBB(sq)) | ((FILE_A_BB | FILE_H_BB) & ~fileBB(sq));
+        Magic&   m     = magics[sq];
+        m.mask         = slidingAttack(type, sq, 0) & ~edges;
+        m.shift        = 64 - popCount(m.mask);
+        m.attacks      = (sq == 0) ? table : magics[sq - 1].attacks + size;
+
+        // Énumération de tous les sous-ensembles du masque (astuce "carry-rippler")
+        Bitboard b = 0;
+        size       = 0;
+        do
+        {
+            occupancy[size] = b;
+            reference[size] = slidingAttack(type, sq, b);
+#if CHESS_USE_PEXT
+            m.attacks[m.index(b)] = reference[size];
+#endif
+            ++size;
+            b = (b - m.mask) & m.mask;
+        } while (b);
+
+#if !CHESS_USE_PEXT
+        MagicRng rng(seeds[rankOf(sq)]);
+        for (int i = 0; i < size;)
+        {
+            for (m.magic = 0; popCount((m.magic * m.mask) >> 56) < 6;)
+                m.magic = rng.sparse();
+
+            // On vérifie que chaque occupation tombe sur une entrée vide ou déjà identique
+            for (++attempt, i = 0; i < size; ++i)
+            {
+                unsigned idx = m.index(occupancy[i]);
+                if (epoch[idx] < attempt)
+                {
+                    epoch[idx]     = attempt;
+                    m.attacks[idx] = reference[i];
+                }
+                else if (m.attacks[idx] != reference[i])
+                {
+                    break;
+                }
+            }
+        }
+#endif
+    }
+}
+
+void init()
+{
+    static constexpr int knightSteps[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+    static constexpr int kingSteps[8][2]   = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+    static constexpr int whitePawn[2][2]   = {{-1, 1}, {1, 1}};
+    static constexpr int blackPawn[2][2]   = {{-1, -1}, {1, -1}};
+
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        KnightAttacks[sq]  = stepAttacks(sq, knightSteps, 8);
+        KingAttacks[sq]    = stepAttacks(sq, kingSteps, 8);
+        PawnAttacks[0][sq] = stepAttacks(sq, whitePawn, 2);
+        PawnAttacks[1][sq] = stepAttacks(sq, blackPawn, 2);
+    }
+
+    initMagics(PieceType::Rook, RookTable, RookMagics);
+    initMagics(PieceType::Bishop, BishopTable, BishopMagics);
+
+    for (int a = 0; a < 64; ++a)
+    {
+        for (int b = 0; b < 64; ++b)
+        {
+            BetweenBB[a][b] = 0;
+            LineBB[a][b]    = 0;
+            for (PieceType type : {PieceType::Bishop, PieceType::Rook})
+            {
+                if (slidingAttack(type, a, 0) & squareBB(b))
+                {
+                    LineBB[a][b]    = (slidingAttack(type, a, 0) & slidingAttack(type, b, 0)) | squareBB(a) | squareBB(b);
+                    BetweenBB[a][b] = slidingAttack(type, a, squareBB(b)) & slidingAttack(type, b, squareBB(a));
+                }
+            }
+        }
+    }
+}
+
+// Les tables sont remplies une seule fois, avant main()
+const bool s_initialized = (init(), true);
+
+} // namespace
+
+} // namespace Attacks
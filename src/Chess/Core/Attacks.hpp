@@ -0,0 +1,69 @@
+#pragma once
+#include <array>
+#include "Bitboard.hpp"
+
+// Avec BMI2 (-mbmi2, cf. option CMake CHESS_ENABLE_BMI2) l'index dans les tables des pièces glissantes
+// est calculé par PEXT, sinon par multiplication "magique" (les nombres magiques sont cherchés au démarrage)
+#if defined(__BMI2__) && !defined(CHESS_NO_PEXT)
+    #include <immintrin.h>
+    #define CHESS_USE_PEXT 1
+#else
+    #define CHESS_USE_PEXT 0
+#endif
+
+// Entrée de la table magique d'une case : masque des cases qui peuvent bloquer, et sous-table des attaques
+struct Magic {
+    Bitboard  mask    = 0;
+    Bitboard  magic   = 0;
+    Bitboard* attacks = nullptr;
+    unsigned  shift   = 0;
+
+    unsigned index(Bitboard occupied) const
+    {
+#if CHESS_USE_PEXT
+        return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+        return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+    }
+};
+
+// Tables d'attaques précalculées au lancement du programme (voir Attacks.cpp)
+namespace Attacks {
+
+extern std::array<Magic, 64>                      RookMagics;
+extern std::array<Magic, 64>                      BishopMagics;
+extern std::array<Bitboard, 64>                   KnightAttacks;
+extern std::array<Bitboard, 64>                   KingAttacks;
+extern std::array<std::array<Bitboard, 64>, 2>    PawnAttacks;
+extern std::array<std::array<Bitboard, 64>, 64>   BetweenBB;
+extern std::array<std::array<Bitboard, 64>, 64>   LineBB;
+
+inline Bitboard knight(int sq) { return KnightAttacks[sq]; }
+inline Bitboard king(int sq) { return KingAttacks[sq]; }
+inline Bitboard pawn(PieceColor color, int sq) { return PawnAttacks[colorIndex(color)][sq]; }
+
+inline Bitboard rook(int sq, Bitboard occupied) { return RookMagics[sq].attacks[RookMagics[sq].index(occupied)]; }
+inline Bitboard bishop(int sq, Bitboard occupied) { return BishopMagics[sq].attacks[BishopMagics[sq].index(occupied)]; }
+inline Bitboard queen(int sq, Bitboard occupied) { return rook(sq, occupied) | bishop(sq, occupied); }
+
+// Cases strictement entre a et b si elles sont alignées (0 sinon)
+inline Bitboard between(int a, int b) { return BetweenBB[a][b]; }
+// Ligne (rangée, colonne ou diagonale) complète passant par a et b (0 si non alignées)
+inline Bitboard line(int a, int b) { return LineBB[a][b]; }
+
+// Attaques d'une pièce qui n'est pas un pion
+inline Bitboard attacks(PieceType type, int sq, Bitboard occupied)
+{
+    switch (type)
+    {
+    case PieceType::Knight: return knight(sq);
+    case PieceType::Bishop: return bishop(sq, occupied);
+    case PieceType::Rook: return rook(sq, occupied);
+    case PieceType::Queen: return queen(sq, occupied);
+    case PieceType::King: return king(sq);
+    default: return 0;
+    }
+}
+
+} // namespace Attacks
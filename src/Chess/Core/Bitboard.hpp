@@ -0,0 +1,58 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include "../Piece.hpp"
+#include "../Position.hpp"
+
+// Un bitboard = un ensemble de cases, le bit i correspond à la case i = x + y * 8
+// (même indexation que l'ancien vector : a1 = 0, h1 = 7, a8 = 56)
+using Bitboard = uint64_t;
+
+constexpr int NO_SQUARE = 64;
+
+constexpr Bitboard FILE_A_BB = 0x0101010101010101ULL;
+constexpr Bitboard FILE_H_BB = FILE_A_BB << 7;
+constexpr Bitboard RANK_1_BB = 0xFFULL;
+constexpr Bitboard RANK_2_BB = RANK_1_BB << 8;
+constexpr Bitboard RANK_4_BB = RANK_1_BB << 24;
+constexpr Bitboard RANK_5_BB = RANK_1_BB << 32;
+constexpr Bitboard RANK_7_BB = RANK_1_BB << 48;
+constexpr Bitboard RANK_8_BB = RANK_1_BB << 56;
+
+constexpr Bitboard DARK_SQUARES_BB  = 0xAA55AA55AA55AA55ULL; // a1, c1... b2, d2...
+constexpr Bitboard LIGHT_SQUARES_BB = ~DARK_SQUARES_BB;
+
+constexpr int fileOf(int sq) { return sq & 7; }
+constexpr int rankOf(int sq) { return sq >> 3; }
+constexpr int makeSquare(int file, int rank) { return file + rank * 8; }
+
+constexpr int      squareOf(Position pos) { return pos.x + pos.y * 8; }
+constexpr Position positionOf(int sq) { return Position{fileOf(sq), rankOf(sq)}; }
+
+constexpr Bitboard squareBB(int sq) { return 1ULL << sq; }
+constexpr Bitboard fileBB(int sq) { return FILE_A_BB << fileOf(sq); }
+constexpr Bitboard rankBB(int sq) { return RANK_1_BB << (rankOf(sq) * 8); }
+
+inline int  popCount(Bitboard b) { return std::popcount(b); }
+inline int  lsb(Bitboard b) { return std::countr_zero(b); }
+inline int  msb(Bitboard b) { return 63 - std::countl_zero(b); }
+inline bool moreThanOne(Bitboard b) { return (b & (b - 1)) != 0; }
+
+// Retire et renvoie la case la plus basse de l'ensemble
+inline int popLsb(Bitboard& b)
+{
+    int sq = lsb(b);
+    b &= b - 1;
+    return sq;
+}
+
+// Décalages d'un ensemble de cases, les bords sont masqués pour ne pas "déborder" d'une colonne à l'autre
+constexpr Bitboard shiftNorth(Bitboard b) { return b << 8; }
+constexpr Bitboard shiftSouth(Bitboard b) { return b >> 8; }
+constexpr Bitboard shiftEast(Bitboard b) { return (b & ~FILE_H_BB) << 1; }
+constexpr Bitboard shiftWest(Bitboard b) { return (b & ~FILE_A_BB) >> 1; }
+
+constexpr int colorIndex(PieceColor color) { return color == PieceColor::White ? 0 : 1; }
+constexpr int typeIndex(PieceType type) { return static_cast<int>(type) - 1; } // Pawn = 0 ... King = 5
+
+constexpr PieceColor operator~(PieceColor color) { return color == PieceColor::White ? PieceColor::Black : PieceColor::White; }
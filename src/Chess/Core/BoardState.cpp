@@ -0,0 +1,335 @@
+#include "BoardState.hpp"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #define BOARD_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define BOARD_SSE2 0
+#endif
+
+namespace {
+
+// Droits de roque conservés quand une pièce part de (ou arrive sur) chaque case
+constexpr std::array<uint8_t, 64> makeCastlingMasks()
+{
+    std::array<uint8_t, 64> masks{};
+    for (auto& mask : masks)
+        mask = AllCastling;
+
+    masks[makeSquare(4, 0)] = AllCastling & ~(WhiteKingSide | WhiteQueenSide);
+    masks[makeSquare(7, 0)] = AllCastling & ~WhiteKingSide;
+    masks[makeSquare(0, 0)] = AllCastling & ~WhiteQueenSide;
+    masks[makeSquare(4, 7)] = AllCastling & ~(BlackKingSide | BlackQueenSide);
+    masks[makeSquare(7, 7)] = AllCastling & ~BlackKingSide;
+    masks[makeSquare(0, 7)] = AllCastling & ~BlackQueenSide;
+    return masks;
+}
+
+constexpr std::array<uint8_t, 64> CastlingMasks = makeCastlingMasks();
+
+// Pour setSquares, tout ce qu'une pièce apporte à la position, indexé directement par son code (type | couleur << 3)
+// et sa case. Rangé par paires : ce qui se cumule par XOR, puis ce qui s'additionne. Le score est tassé dans un entier
+// (milieu de partie en bas, fin de partie * 2^32 : la retenue d'un milieu de partie négatif se corrige au décodage),
+// le matériel occupe les 48 bits bas de material, la phase les 16 bits hauts
+constexpr int      PACKED_PHASE_SHIFT   = 48;
+constexpr uint64_t PACKED_MATERIAL_MASK = (1ULL << PACKED_PHASE_SHIFT) - 1;
+
+struct alignas(16) PieceSquare {
+    uint64_t key     = 0;
+    uint64_t pawnKey = 0; // la clé pour un pion, 0 sinon
+    int64_t  psqt    = 0;
+    uint64_t material = 0;
+};
+
+struct SquareCodeTables {
+    std::array<PieceSquare, 16 * 64> pieceSquares{}; // [code * 64 + case]
+};
+
+constexpr SquareCodeTables makeSquareCodeTables()
+{
+    SquareCodeTables tables;
+    for (int color = 0; color < 2; ++color)
+    {
+        for (int type = 0; type < 6; ++type)
+        {
+            const int      code     = (type + 1) | (color << 3);
+            const uint64_t material = (1ULL << (4 * (color * 6 + type))) | (static_cast<uint64_t>(Psqt::PHASE_WEIGHTS[type]) << PACKED_PHASE_SHIFT);
+            for (int sq = 0; sq < 64; ++sq)
+            {
+                const Psqt::Score score = Psqt::TABLE[color][type][sq];
+                const uint64_t    key   = Zobrist::PieceKeys[color][type][sq];
+                const auto        eg    = static_cast<uint64_t>(static_cast<int64_t>(score.eg)) << 32;
+                tables.pieceSquares[code * 64 + sq] = {key, type == 0 ? key : 0, static_cast<int64_t>(eg) + score.mg, material};
+            }
+        }
+    }
+    return tables;
+}
+
+constexpr SquareCodeTables CodeTables = makeSquareCodeTables();
+
+} // namespace
+
+void BoardState::clear()
+{
+    m_pieces         = {};
+    m_occupancy      = {};
+    m_occupied       = 0;
+    m_squares        = {};
+    m_sideToMove     = PieceColor::White;
+    m_castling       = NoCastling;
+    m_epSquare       = NO_SQUARE;
+    m_halfmoveClock  = 0;
+    m_fullmoveNumber = 1;
+    m_key            = 0; // position vide, trait aux blancs, aucun droit : toutes les clés s'annulent
+    m_pawnKey        = 0;
+    m_materialKey    = 0;
+    m_psqt           = {};
+    m_phase          = 0;
+    m_history.clear();
+}
+
+void BoardState::setSquares(const std::array<uint8_t, 64>& squares)
+{
+    m_squares = squares;
+
+    // Un plan de bits par bit du code : les trois bits du type, puis la couleur
+    std::array<Bitboard, 4> planes{};
+#if BOARD_SSE2
+    // pmovmskb prend le bit de poids fort de chaque octet : décalé de 7 - bit, c'est le bit voulu des 16 cases
+    __m128i chunks[4];
+    for (int i = 0; i < 4; ++i)
+        chunks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(squares.data() + 16 * i));
+    for (int bit = 0; bit < 4; ++bit)
+    {
+        for (int i = 0; i < 4; ++i)
+            planes[bit] |= static_cast<Bitboard>(_mm_movemask_epi8(_mm_slli_epi16(chunks[i], 7 - bit)) & 0xFFFF) << (16 * i);
+    }
+#else
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        for (int bit = 0; bit < 4; ++bit)
+            planes[bit] |= static_cast<Bitboard>((squares[sq] >> bit) & 1) << sq;
+    }
+#endif
+    m_occupied     = planes[0] | planes[1] | planes[2];
+    m_occupancy[0] = m_occupied & ~planes[3];
+    m_occupancy[1] = planes[3];
+    for (int type = 1; type <= 6; ++type)
+    {
+        const Bitboard b = ((type & 1) ? planes[0] : ~planes[0]) & ((type & 2) ? planes[1] : ~planes[1]) & ((type & 4) ? planes[2] : ~planes[2]);
+        m_pieces[0][type - 1] = b & m_occupancy[0];
+        m_pieces[1][type - 1] = b & m_occupancy[1];
+    }
+
+    // Une seule boucle sur les pièces, tout indexé par le code de la case : pas de boucle (et de sortie de boucle
+    // mal prédite) par type de pièce
+    uint64_t key = 0, pawnKey = 0, material = 0;
+    int64_t  psqt = 0;
+#if BOARD_SSE2
+    // Deux instructions par pièce : un XOR pour les deux signatures, une addition pour le score et le matériel
+    __m128i keys = _mm_setzero_si128(), sums = _mm_setzero_si128();
+    for (Bitboard b = m_occupied; b; b &= b - 1)
+    {
+        const unsigned     sq    = static_cast<unsigned>(lsb(b));
+        const PieceSquare& piece = CodeTables.pieceSquares[squares[sq] << 6 | sq];
+        keys                     = _mm_xor_si128(keys, _mm_load_si128(reinterpret_cast<const __m128i*>(&piece.key)));
+        sums                     = _mm_add_epi64(sums, _mm_load_si128(reinterpret_cast<const __m128i*>(&piece.psqt)));
+    }
+    alignas(16) uint64_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), keys);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes + 2), sums);
+    key      = lanes[0];
+    pawnKey  = lanes[1];
+    psqt     = static_cast<int64_t>(lanes[2]);
+    material = lanes[3];
+#else
+    for (Bitboard b = m_occupied; b; b &= b - 1)
+    {
+        const unsigned     sq    = static_cast<unsigned>(lsb(b));
+        const PieceSquare& piece = CodeTables.pieceSquares[squares[sq] << 6 | sq];
+        key ^= piece.key;
+        pawnKey ^= piece.pawnKey;
+        psqt += piece.psqt;
+        material += piece.material;
+    }
+#endif
+    const int mg = static_cast<int32_t>(static_cast<uint32_t>(psqt));
+    m_key         = key; // trait aux blancs, aucun droit ni case en passant : rien d'autre dans la signature
+    m_pawnKey     = pawnKey;
+    m_materialKey = material & PACKED_MATERIAL_MASK;
+    m_phase       = static_cast<int>(material >> PACKED_PHASE_SHIFT);
+    m_psqt        = {mg, static_cast<int>((psqt - mg) >> 32)};
+
+    // Le reste comme clear(), sans tout remettre à zéro avant de le réécrire
+    m_sideToMove     = PieceColor::White;
+    m_castling       = NoCastling;
+    m_epSquare       = NO_SQUARE;
+    m_halfmoveClock  = 0;
+    m_fullmoveNumber = 1;
+    m_history.clear();
+}
+
+//Déplace la pièce (et capture ce qu'il y a sur la case d'arrivée), sans toucher au trait
+void BoardState::move(int from, int to)
+{
+    uint8_t code = m_squares[from];
+    if (code == 0 || from == to)
+        return;
+
+    removePiece(to);
+    removePiece(from);
+    addPiece(to, static_cast<PieceType>(code & 7), (code >> 3) ? PieceColor::Black : PieceColor::White);
+}
+
+void BoardState::makeMove(Move move)
+{
+    const int        from  = move.from();
+    const int        to    = move.to();
+    const PieceColor us    = m_sideToMove;
+    const PieceType  moved = typeAt(from);
+
+    // Case de départ vide : le coup compte comme un coup nul, pour que chaque makeMove() ait son unmakeMove()
+    // et que l'historique garde un demi-coup par entrée (isRepetition() en dépend)
+    if (moved == PieceType::None)
+    {
+        makeNullMove();
+        return;
+    }
+
+    m_history.push_back({move, 0, m_castling, static_cast<int8_t>(m_epSquare), static_cast<uint16_t>(m_halfmoveClock), m_key, m_pawnKey});
+
+    ++m_halfmoveClock;
+    setEnPassantSquare(NO_SQUARE);
+    setCastlingRights(m_castling & CastlingMasks[from] & CastlingMasks[to]);
+
+    if (move.isCastling())
+    {
+        // La tour saute par-dessus le roi : h -> f pour le petit roque, a -> d pour le grand
+        const int rank     = rankOf(from);
+        const int rookFrom = makeSquare(move.flags() == KingCastle ? 7 : 0, rank);
+        const int rookTo   = makeSquare(move.flags() == KingCastle ? 5 : 3, rank);
+        removePiece(from);
+        removePiece(rookFrom);
+        addPiece(to, PieceType::King, us);
+        addPiece(rookTo, PieceType::Rook, us);
+    }
+    else
+    {
+        if (move.isEnPassant())
+        {
+            removePiece(to + (us == PieceColor::White ? -8 : 8));
+            m_halfmoveClock = 0;
+        }
+        else if (!isEmpty(to))
+        {
+            m_history.back().captured = m_squares[to];
+            removePiece(to);
+            m_halfmoveClock = 0;
+        }
+
+        removePiece(from);
+        addPiece(to, move.isPromotion() ? move.promotionType() : moved, us);
+
+        if (moved == PieceType::Pawn)
+        {
+            m_halfmoveClock = 0;
+
+            // La case en passant n'est retenue que si un pion adverse peut réellement prendre
+            if (move.flags() == DoublePawnPush)
+            {
+                const int epSquare = (from + to) / 2;
+                if (Attacks::pawn(us, epSquare) & pieces(~us, PieceType::Pawn))
+                    setEnPassantSquare(epSquare);
+            }
+        }
+    }
+
+    if (us == PieceColor::Black)
+        ++m_fullmoveNumber;
+    m_sideToMove = ~us;
+    m_key ^= Zobrist::SideKey;
+}
+
+void BoardState::unmakeMove()
+{
+    const UndoInfo   undo = m_history.back();
+    const Move       move = undo.move;
+    const int        from = move.from();
+    const int        to   = move.to();
+    const PieceColor us   = ~m_sideToMove; // celui qui avait joué le coup
+    m_history.pop_back();
+
+    if (!move)
+    {
+        // Coup nul : aucune pièce n'a bougé
+    }
+    else if (move.isCastling())
+    {
+        const int rank     = rankOf(from);
+        const int rookFrom = makeSquare(move.flags() == KingCastle ? 7 : 0, rank);
+        const int rookTo   = makeSquare(move.flags() == KingCastle ? 5 : 3, rank);
+        removePiece(to);
+        removePiece(rookTo);
+        addPiece(from, PieceType::King, us);
+        addPiece(rookFrom, PieceType::Rook, us);
+    }
+    else
+    {
+        const PieceType moved = move.isPromotion() ? PieceType::Pawn : typeAt(to);
+        removePiece(to);
+        addPiece(from, moved, us);
+
+        if (move.isEnPassant())
+            addPiece(to + (us == PieceColor::White ? -8 : 8), PieceType::Pawn, ~us);
+        else if (undo.captured)
+            addPiece(to, static_cast<PieceType>(undo.captured & 7), (undo.captured >> 3) ? PieceColor::Black : PieceColor::White);
+    }
+
+    m_sideToMove    = us;
+    m_castling      = undo.castling;
+    m_epSquare      = undo.epSquare;
+    m_halfmoveClock = undo.halfmoveClock;
+    m_key           = undo.key;
+    m_pawnKey       = undo.pawnKey;
+    if (us == PieceColor::Black)
+        --m_fullmoveNumber;
+}
+
+void BoardState::makeNullMove()
+{
+    m_history.push_back({Move::none(), 0, m_castling, static_cast<int8_t>(m_epSquare), static_cast<uint16_t>(m_halfmoveClock), m_key, m_pawnKey});
+
+    // Remis à zéro pour que la détection des répétitions ne traverse pas le coup nul
+    m_halfmoveClock = 0;
+    setEnPassantSquare(NO_SQUARE);
+    if (m_sideToMove == PieceColor::Black)
+        ++m_fullmoveNumber;
+    m_sideToMove = ~m_sideToMove;
+    m_key ^= Zobrist::SideKey;
+}
+
+bool BoardState::isRepetition() const
+{
+    // m_history[n - i].key est la position d'il y a i demi-coups : même trait si i est pair,
+    // et rien ne peut se répéter avant le dernier coup de pion ou la dernière prise
+    const int count = static_cast<int>(m_history.size());
+    const int limit = std::min(m_halfmoveClock, count);
+    for (int i = 4; i <= limit; i += 2)
+    {
+        if (m_history[count - i].key == m_key)
+            return true;
+    }
+    return false;
+}
+
+std::vector<Piece> BoardState::toList() const
+{
+    std::vector<Piece> list(64);
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        list[sq] = get(sq);
+    }
+    return list;
+}
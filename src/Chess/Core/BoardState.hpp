@@ -0,0 +1,259 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Attacks.hpp"
+#include "Bitboard.hpp"
+#include "Move.hpp"
+#include "Psqt.hpp"
+#include "Zobrist.hpp"
+
+enum CastlingRight : uint8_t {
+    NoCastling     = 0,
+    WhiteKingSide  = 1,
+    WhiteQueenSide = 2,
+    BlackKingSide  = 4,
+    BlackQueenSide = 8,
+    AllCastling    = 15,
+};
+
+// Ce qu'il faut pour défaire un coup : tout le reste se déduit du coup lui-même
+struct UndoInfo {
+    Move     move;
+    uint8_t  captured;      // code de la pièce prise (0 = aucune)
+    uint8_t  castling;      // droits de roque avant le coup
+    int8_t   epSquare;      // case en passant avant le coup
+    uint16_t halfmoveClock; // compteur des 50 coups avant le coup
+    uint64_t key;           // signatures avant le coup : restaurées telles quelles
+    uint64_t pawnKey;
+};
+
+// Représentation "moteur" de la position : un bitboard par type de pièce et par couleur,
+// les ensembles d'occupation, et un petit tableau de 64 octets pour savoir en O(1) ce qu'il y a sur une case.
+// Aucune dépendance à ImGui / OpenGL : c'est ce que manipulent les règles.
+class BoardState {
+public:
+    BoardState() { clear(); }
+
+    void clear();
+
+    Piece get(int sq) const;
+    Piece get(Position pos) const { return get(squareOf(pos)); }
+    void  set(int sq, Piece piece);
+    void  set(Position pos, Piece piece) { set(squareOf(pos), piece); }
+    void  move(int from, int to);
+    void  move(Position from, Position to) { move(squareOf(from), squareOf(to)); }
+
+    // Remplace toute la position (lecture FEN) : comme clear() puis un set() par pièce, les pièces étant données case
+    // par case avec le codage de m_squares (type | couleur << 3, 0 = case vide). Les bitboards sont extraits des
+    // 64 octets en bloc et les signatures cumulées en un seul passage sur les pièces
+    void setSquares(const std::array<uint8_t, 64>& squares);
+
+    // Joue un coup produit par le générateur (roque, prise en passant, promotion compris) et passe le trait.
+    // Un coup "normal" non légal (mode bourré) est accepté : la pièce va simplement sur la case d'arrivée.
+    // Chaque coup empile un UndoInfo : unmakeMove() revient exactement à la position précédente.
+    // Depuis une case vide, rien ne bouge mais le trait passe, comme avec makeNullMove().
+    void makeMove(Move move);
+    void unmakeMove();
+
+    // Passe le trait sans bouger de pièce (élagage par coup nul) ; se défait aussi avec unmakeMove()
+    void makeNullMove();
+
+    // Le camp a-t-il autre chose que des pions et son roi ? (sinon, gare au zugzwang)
+    bool hasNonPawnMaterial(PieceColor color) const
+    {
+        return (occupancy(color) & ~pieces(color, PieceType::Pawn) & ~pieces(color, PieceType::King)) != 0;
+    }
+
+    // Coups joués depuis le chargement de la position (le plus récent à la fin)
+    size_t          plyCount() const { return m_history.size(); }
+    const UndoInfo& lastUndo() const { return m_history.back(); }
+
+    // La position courante est-elle déjà apparue depuis le dernier coup irréversible ?
+    // (une seule répétition suffit à la recherche pour la considérer comme nulle)
+    bool isRepetition() const;
+
+    bool      isEmpty(int sq) const { return m_squares[sq] == 0; }
+    PieceType typeAt(int sq) const { return static_cast<PieceType>(m_squares[sq] & 7); }
+
+    Bitboard pieces(PieceColor color, PieceType type) const { return m_pieces[colorIndex(color)][typeIndex(type)]; }
+    Bitboard pieces(PieceType type) const { return m_pieces[0][typeIndex(type)] | m_pieces[1][typeIndex(type)]; }
+    Bitboard occupancy(PieceColor color) const { return m_occupancy[colorIndex(color)]; }
+    Bitboard occupancy() const { return m_occupied; }
+
+    PieceColor sideToMove() const { return m_sideToMove; }
+    uint8_t    castlingRights() const { return m_castling; }
+    int        enPassantSquare() const { return m_epSquare; }
+    int        halfmoveClock() const { return m_halfmoveClock; }
+    int        fullmoveNumber() const { return m_fullmoveNumber; }
+
+    // Signature de Zobrist, tenue à jour à chaque modification (jamais recalculée sur les 64 cases)
+    uint64_t key() const { return m_key; }
+    // Signature des seuls pions, pour les tables de structure de pions
+    uint64_t pawnKey() const { return m_pawnKey; }
+
+    // Signature du matériel : le nombre de pièces de chaque sorte, 4 bits par (couleur, type).
+    // Deux positions avec les mêmes pièces (où qu'elles soient) ont la même, et on peut la relire directement
+    uint64_t materialKey() const { return m_materialKey; }
+    static constexpr uint64_t materialUnit(PieceColor color, PieceType type) { return 1ULL << (4 * (colorIndex(color) * 6 + typeIndex(type))); }
+
+    // Matériel + tables pièce-case (positif = bon pour les blancs) et phase de jeu (Psqt::PHASE_MAX au départ),
+    // tenus à jour comme les signatures : l'évaluation n'a plus à parcourir l'échiquier
+    Psqt::Score psqt() const { return m_psqt; }
+    int         phase() const { return m_phase; }
+
+    // Signature (approchée) après le coup, sans le jouer : suffisant pour précharger une entrée de table.
+    // Les nouveaux droits de roque, la nouvelle case en passant et la tour du roque sont ignorés.
+    uint64_t keyAfter(Move move) const
+    {
+        const int       from  = move.from();
+        const int       to    = move.to();
+        const PieceType moved = typeAt(from);
+        if (moved == PieceType::None)
+            return m_key;
+
+        uint64_t key = m_key ^ Zobrist::SideKey ^ Zobrist::piece(m_sideToMove, moved, from)
+                       ^ Zobrist::piece(m_sideToMove, move.isPromotion() ? move.promotionType() : moved, to);
+        if (!isEmpty(to) && !move.isCastling())
+            key ^= Zobrist::piece(~m_sideToMove, typeAt(to), to);
+        if (m_epSquare != NO_SQUARE)
+            key ^= Zobrist::EnPassantKeys[fileOf(m_epSquare)];
+        return key;
+    }
+
+    void setSideToMove(PieceColor color)
+    {
+        if (color != m_sideToMove)
+            m_key ^= Zobrist::SideKey;
+        m_sideToMove = color;
+    }
+    void setCastlingRights(uint8_t rights)
+    {
+        m_key ^= Zobrist::CastlingKeys[m_castling] ^ Zobrist::CastlingKeys[rights];
+        m_castling = rights;
+    }
+    void setEnPassantSquare(int sq)
+    {
+        if (m_epSquare != NO_SQUARE)
+            m_key ^= Zobrist::EnPassantKeys[fileOf(m_epSquare)];
+        if (sq != NO_SQUARE)
+            m_key ^= Zobrist::EnPassantKeys[fileOf(sq)];
+        m_epSquare = sq;
+    }
+    void setMoveCounters(int halfmoveClock, int fullmoveNumber)
+    {
+        m_halfmoveClock  = halfmoveClock;
+        m_fullmoveNumber = fullmoveNumber;
+    }
+
+    // Case du roi, NO_SQUARE s'il a disparu (possible en mode bourré)
+    int kingSquare(PieceColor color) const
+    {
+        Bitboard king = pieces(color, PieceType::King);
+        return king ? lsb(king) : NO_SQUARE;
+    }
+
+    // Toutes les pièces (des deux camps) qui attaquent la case, pour une occupation donnée
+    Bitboard attackersTo(int sq, Bitboard occupied) const;
+    Bitboard checkers() const;
+    bool     inCheck() const { return checkers() != 0; }
+
+    // Vue "une Piece par case" générée à la demande (pour le rendu 3D)
+    std::vector<Piece> toList() const;
+
+private:
+    void addPiece(int sq, PieceType type, PieceColor color);
+    void removePiece(int sq);
+
+    static uint8_t encode(PieceType type, PieceColor color) { return static_cast<uint8_t>(static_cast<int>(type) | (colorIndex(color) << 3)); }
+
+    std::array<std::array<Bitboard, 6>, 2> m_pieces{};
+    std::array<Bitboard, 2>                m_occupancy{};
+    Bitboard                               m_occupied = 0;
+    std::array<uint8_t, 64>                m_squares{}; // type | couleur << 3, 0 = case vide
+
+    PieceColor  m_sideToMove     = PieceColor::White;
+    uint8_t     m_castling       = NoCastling;
+    int         m_epSquare       = NO_SQUARE; // case d'arrivée d'une prise en passant possible
+    int         m_halfmoveClock  = 0;
+    int         m_fullmoveNumber = 1;
+    uint64_t    m_key            = 0;
+    uint64_t    m_pawnKey        = 0;
+    uint64_t    m_materialKey    = 0;
+    Psqt::Score m_psqt;
+    int         m_phase          = 0; // de 0 (rois et pions) à Psqt::PHASE_MAX (matériel complet)
+
+    // Pile d'annulation : sa capacité reste acquise, un arbre de recherche n'alloue donc plus après les premiers coups
+    std::vector<UndoInfo> m_history;
+};
+
+inline void BoardState::addPiece(int sq, PieceType type, PieceColor color)
+{
+    Bitboard b = squareBB(sq);
+    m_pieces[colorIndex(color)][typeIndex(type)] |= b;
+    m_occupancy[colorIndex(color)] |= b;
+    m_occupied |= b;
+    m_squares[sq] = encode(type, color);
+    m_materialKey += materialUnit(color, type);
+    m_psqt += Psqt::score(color, type, sq);
+    m_phase += Psqt::PHASE_WEIGHTS[typeIndex(type)];
+
+    const uint64_t key = Zobrist::PieceKeys[colorIndex(color)][typeIndex(type)][sq];
+    m_key ^= key;
+    if (type == PieceType::Pawn)
+        m_pawnKey ^= key;
+}
+
+inline void BoardState::removePiece(int sq)
+{
+    uint8_t code = m_squares[sq];
+    if (code == 0)
+        return;
+
+    Bitboard b     = ~squareBB(sq);
+    int      color = code >> 3;
+    int      type  = (code & 7) - 1;
+    m_pieces[color][type] &= b;
+    m_occupancy[color] &= b;
+    m_occupied &= b;
+    m_squares[sq] = 0;
+    m_materialKey -= 1ULL << (4 * (color * 6 + type));
+    m_psqt -= Psqt::TABLE[color][type][sq];
+    m_phase -= Psqt::PHASE_WEIGHTS[type];
+
+    const uint64_t key = Zobrist::PieceKeys[color][type][sq];
+    m_key ^= key;
+    if (type == typeIndex(PieceType::Pawn))
+        m_pawnKey ^= key;
+}
+
+inline Piece BoardState::get(int sq) const
+{
+    const uint8_t code = m_squares[sq];
+    if (code == 0)
+        return {PieceType::None, PieceColor::White};
+    return {static_cast<PieceType>(code & 7), (code >> 3) ? PieceColor::Black : PieceColor::White};
+}
+
+inline void BoardState::set(int sq, Piece piece)
+{
+    removePiece(sq);
+    if (piece.type != PieceType::None)
+        addPiece(sq, piece.type, piece.color);
+}
+
+inline Bitboard BoardState::attackersTo(int sq, Bitboard occupied) const
+{
+    return (Attacks::pawn(PieceColor::White, sq) & pieces(PieceColor::Black, PieceType::Pawn))
+           | (Attacks::pawn(PieceColor::Black, sq) & pieces(PieceColor::White, PieceType::Pawn))
+           | (Attacks::knight(sq) & pieces(PieceType::Knight))
+           | (Attacks::bishop(sq, occupied) & (pieces(PieceType::Bishop) | pieces(PieceType::Queen)))
+           | (Attacks::rook(sq, occupied) & (pieces(PieceType::Rook) | pieces(PieceType::Queen)))
+           | (Attacks::king(sq) & pieces(PieceType::King));
+}
+
+inline Bitboard BoardState::checkers() const
+{
+    int ksq = kingSquare(m_sideToMove);
+    return ksq == NO_SQUARE ? 0 : attackersTo(ksq, m_occupied) & occupancy(~m_sideToMove);
+}
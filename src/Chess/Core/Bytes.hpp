@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+// Entiers en petit-boutiste dans les fichiers binaires (archives, index) : le même fichier se lit sur toutes
+// les machines, et le compilateur réduit ces boucles à un simple mov sur x86.
+namespace Bytes {
+
+inline void put16(uint8_t* out, uint16_t value)
+{
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+inline void put32(uint8_t* out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+inline void put64(uint8_t* out, uint64_t value)
+{
+    for (int i = 0; i < 8; ++i)
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+inline uint16_t get16(const uint8_t* in)
+{
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+inline uint32_t get32(const uint8_t* in)
+{
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; --i)
+        value = (value << 8) | in[i];
+    return value;
+}
+
+inline uint64_t get64(const uint8_t* in)
+{
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i)
+        value = (value << 8) | in[i];
+    return value;
+}
+
+} // namespace Bytes
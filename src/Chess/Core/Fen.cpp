@@ -0,0 +1,587 @@
+#include "Fen.hpp"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include "San.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define FEN_SSE2 1
+#include <emmintrin.h>
+#else
+#define FEN_SSE2 0
+#endif
+
+namespace {
+
+// Le placement est lu comme une grille de 9 cellules par rangée, les 8 cases puis le '/' qui la termine : chaque
+// caractère écrit son code dans la cellule courante et avance de sa largeur (1 pour une pièce ou un '/', n pour n
+// cases vides). Une FEN bien formée remplit exactement 71 cellules avec les '/' dans la 9e colonne, ce qui se vérifie
+// après la boucle : elle n'a aucun branchement sur le caractère, seulement des tables.
+// Les cellules sont rangées directement à leur place : les cases dans l'ordre de BoardState (a1 = 0), puis les
+// fins de rangée, puis une cellule poubelle pour ce qui déborde
+constexpr int     GRID_CELLS      = 9 * 8 - 1;
+constexpr int     ROW_ENDS        = 64;
+constexpr int     OVERFLOW_CELL   = ROW_ENDS + 7;
+constexpr uint8_t SLASH_CODE      = 0x80; // jamais le code d'une pièce
+constexpr uint8_t END_OF_FIELD    = 0;    // largeur d'une espace : le champ s'arrête là
+constexpr uint8_t INVALID_ADVANCE = 100;  // caractère interdit : la grille déborde forcément
+
+struct PlacementTables {
+    std::array<uint8_t, 256> codes{};
+    std::array<uint8_t, 256> advances{};
+    std::array<uint8_t, 128> cellIndex{}; // cellule de la grille (modulo 128) -> place dans le tableau des cases
+};
+
+constexpr PlacementTables buildPlacementTables()
+{
+    PlacementTables tables;
+    for (uint8_t& advance : tables.advances)
+        advance = INVALID_ADVANCE;
+
+    constexpr std::string_view letters = "PRNBQK"; // dans l'ordre de PieceType
+    for (int type = 0; type < 6; ++type)
+    {
+        const auto white = static_cast<unsigned char>(letters[type]);
+        const auto black = static_cast<unsigned char>(letters[type] + 32);
+        tables.codes[white]    = static_cast<uint8_t>(type + 1);
+        tables.codes[black]    = static_cast<uint8_t>((type + 1) | 8);
+        tables.advances[white] = tables.advances[black] = 1;
+    }
+    for (int empty = 1; empty <= 8; ++empty)
+        tables.advances['0' + empty] = static_cast<uint8_t>(empty);
+    tables.codes['/']     = SLASH_CODE;
+    tables.advances['/']  = 1;
+    tables.advances[' ']  = END_OF_FIELD;
+    tables.advances['\t'] = END_OF_FIELD;
+
+    // Rangée 8 en premier dans la FEN
+    for (int cell = 0; cell < 128; ++cell)
+    {
+        const int row = cell / 9, column = cell % 9;
+        tables.cellIndex[cell] = static_cast<uint8_t>(cell >= GRID_CELLS ? OVERFLOW_CELL : column == 8 ? ROW_ENDS + row : 8 * (7 - row) + column);
+    }
+    return tables;
+}
+
+constexpr PlacementTables PLACEMENT = buildPlacementTables();
+
+// Droit de roque de chaque lettre du champ, 0 pour tout autre caractère
+constexpr std::array<uint8_t, 256> buildCastlingChars()
+{
+    std::array<uint8_t, 256> chars{};
+    chars['K'] = WhiteKingSide;
+    chars['Q'] = WhiteQueenSide;
+    chars['k'] = BlackKingSide;
+    chars['q'] = BlackQueenSide;
+    return chars;
+}
+
+constexpr std::array<uint8_t, 256> CASTLING_CHARS = buildCastlingChars();
+
+// Lecture d'un champ : la vue avance au fur et à mesure, comme un flux mais sans copie
+void skipSpaces(std::string_view& text)
+{
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+        text.remove_prefix(1);
+}
+
+std::string_view nextField(std::string_view& text)
+{
+    skipSpaces(text);
+    size_t length = 0;
+    while (length < text.size() && text[length] != ' ' && text[length] != '\t')
+        ++length;
+    const std::string_view field = text.substr(0, length);
+    text.remove_prefix(length);
+    return field;
+}
+
+// Nombre au début de text : renvoie le nombre de chiffres lus (pas de signe). Au-delà de 9 chiffres le nombre
+// déborde, mais sa longueur suffit à le refuser
+size_t readDigits(std::string_view text, int& value)
+{
+    size_t   length = 0;
+    uint32_t number = 0;
+    while (length < text.size() && length < 10 && static_cast<unsigned>(text[length] - '0') < 10)
+        number = number * 10 + static_cast<unsigned>(text[length++] - '0');
+    value = static_cast<int>(number);
+    return length;
+}
+
+bool parseNumber(std::string_view field, int& value)
+{
+    int          number = 0;
+    const size_t length = readDigits(field, number);
+    if (length == 0 || length > 9 || length != field.size())
+        return false;
+    value = number;
+    return true;
+}
+
+// Compteur facultatif de la FEN : true s'il est absent (value inchangée) ou bien formé
+bool readCounter(std::string_view& text, int& value)
+{
+    skipSpaces(text);
+    if (text.empty())
+        return true;
+
+    int          number = 0;
+    const size_t length = readDigits(text, number);
+    if (length == 0 || length > 9 || (length < text.size() && text[length] != ' ' && text[length] != '\t'))
+        return false;
+    value = number;
+    text.remove_prefix(length);
+    return true;
+}
+
+// Opération EPD au début de text : renvoie la longueur jusqu'au ';' qui la termine (hors guillemets), npos s'il
+// manque, et range dans opcodeLength la position de la première espace (npos si aucune)
+size_t operationLength(std::string_view text, size_t& opcodeLength)
+{
+    opcodeLength = std::string_view::npos;
+    bool quoted  = false;
+    for (size_t length = 0; length < text.size(); ++length)
+    {
+        const char c = text[length];
+        if (c == ';' && !quoted)
+            return length;
+        quoted ^= c == '"';
+        if ((c == ' ' || c == '\t') && opcodeLength == std::string_view::npos)
+            opcodeLength = length;
+    }
+    return std::string_view::npos;
+}
+
+#if FEN_SSE2
+// Un bit par caractère remarquable des 64 premiers octets de text (bit i pour text[i], rien au-delà de la fin).
+// Le texte est lu par blocs de 16 octets ; le dernier est relu en reculant jusqu'à 16 octets avant la fin, il faut
+// donc que la ligne commence au moins 16 octets avant (toujours vrai derrière une position)
+struct CharMasks {
+    uint64_t blanks     = 0; // espaces et tabulations
+    uint64_t semicolons = 0;
+    uint64_t quotes     = 0;
+    uint64_t lineEnds   = 0; // '\r' et '\n'
+};
+
+CharMasks charMasks(std::string_view text)
+{
+    CharMasks         masks;
+    const char* const end = text.data() + text.size();
+    for (size_t offset = 0; offset < text.size() && offset < 64; offset += 16)
+    {
+        const size_t   remaining = text.size() - offset;
+        const unsigned shift     = remaining >= 16 ? 0 : static_cast<unsigned>(16 - remaining);
+        const __m128i  bytes     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(remaining >= 16 ? text.data() + offset : end - 16));
+        const auto     mask      = [&](char c) {
+            return static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(c)))) >> shift) << offset;
+        };
+        masks.blanks |= mask(' ') | mask('\t');
+        masks.semicolons |= mask(';');
+        masks.quotes |= mask('"');
+        masks.lineEnds |= mask('\r') | mask('\n');
+    }
+    return masks;
+}
+#endif
+
+// Lit le placement au début de text et le consomme
+FenError parsePlacement(BoardState& board, std::string_view& text)
+{
+    std::array<uint8_t, OVERFLOW_CELL + 1> cells{};
+    unsigned                               cell   = 0;
+    size_t                                 length = 0;
+    for (; length < text.size(); ++length)
+    {
+        const auto    c       = static_cast<unsigned char>(text[length]);
+        const uint8_t advance = PLACEMENT.advances[c];
+        if (advance == END_OF_FIELD)
+            break;
+        cells[PLACEMENT.cellIndex[cell & 127]] = PLACEMENT.codes[c];
+        cell += advance;
+    }
+    text.remove_prefix(length);
+    if (cell != GRID_CELLS)
+        return FenError::Placement;
+
+    // Un '/' au milieu d'une rangée, ou une rangée terminée par autre chose qu'un '/'
+    uint64_t codes = 0;
+    unsigned ends  = 0;
+    for (int i = 0; i < 64; i += 8)
+    {
+        uint64_t eight;
+        std::memcpy(&eight, &cells[i], 8);
+        codes |= eight;
+    }
+    for (int row = 0; row < 7; ++row)
+        ends |= cells[ROW_ENDS + row] ^ SLASH_CODE;
+    if ((codes & 0x8080808080808080ULL) || ends)
+        return FenError::Placement;
+
+    std::array<uint8_t, 64> squares;
+    std::memcpy(squares.data(), cells.data(), 64);
+    board.setSquares(squares);
+    return FenError::None;
+}
+
+// Les quatre champs communs à la FEN et à l'EPD : placement, trait, roques, en passant
+FenError parsePosition(BoardState& board, std::string_view& text)
+{
+    skipSpaces(text);
+    if (FenError error = parsePlacement(board, text); error != FenError::None)
+        return error;
+
+    // Trait, roques, en passant : des champs de 1 à 4 caractères, lus directement plutôt que découpés un par un
+    skipSpaces(text);
+    if (text.empty() || (text[0] != 'w' && text[0] != 'b') || (text.size() > 1 && text[1] != ' ' && text[1] != '\t'))
+        return FenError::SideToMove;
+    board.setSideToMove(text[0] == 'w' ? PieceColor::White : PieceColor::Black);
+    text.remove_prefix(1);
+
+    skipSpaces(text);
+    uint8_t rights = NoCastling;
+    size_t  length = 0;
+    if (!text.empty() && text[0] == '-')
+        length = 1;
+    else
+    {
+        // Chaque lettre est un bit : une lettre répétée ou inconnue se voit au nombre de bits
+        while (length < text.size() && length < 5 && CASTLING_CHARS[static_cast<unsigned char>(text[length])])
+            rights |= CASTLING_CHARS[static_cast<unsigned char>(text[length++])];
+        if (length == 0 || std::popcount(rights) != static_cast<int>(length))
+            return FenError::Castling;
+    }
+    if (length < text.size() && text[length] != ' ' && text[length] != '\t')
+        return FenError::Castling;
+    board.setCastlingRights(rights);
+    text.remove_prefix(length);
+
+    skipSpaces(text);
+    if (!text.empty() && text[0] == '-')
+        length = 1;
+    else
+    {
+        if (text.size() < 2 || text[0] < 'a' || text[0] > 'h' || text[1] < '1' || text[1] > '8')
+            return FenError::EnPassant;
+        board.setEnPassantSquare(makeSquare(text[0] - 'a', text[1] - '1'));
+        length = 2;
+    }
+    if (length < text.size() && text[length] != ' ' && text[length] != '\t')
+        return FenError::EnPassant;
+    text.remove_prefix(length);
+    return FenError::None;
+}
+
+bool pieceOn(const BoardState& board, int sq, PieceColor color, PieceType type)
+{
+    return board.pieces(color, type) & squareBB(sq);
+}
+
+// Ce que les règles supposent partout ailleurs : un roi par camp, des pions sur les rangées 2 à 7,
+// des droits de roque qui correspondent à l'échiquier, une case en passant plausible, pas de roi adverse en prise.
+// Comme dans makeMove, la case en passant n'est gardée que si un pion peut vraiment prendre : sinon la même position
+// aurait une autre signature selon qu'elle vient d'une FEN ou de coups joués
+FenError validate(BoardState& board)
+{
+    const Bitboard whiteKing = board.pieces(PieceColor::White, PieceType::King);
+    const Bitboard blackKing = board.pieces(PieceColor::Black, PieceType::King);
+    if (!whiteKing || moreThanOne(whiteKing) || !blackKing || moreThanOne(blackKing))
+        return FenError::Kings;
+    if (board.pieces(PieceType::Pawn) & (RANK_1_BB | RANK_8_BB))
+        return FenError::Pawns;
+
+    const uint8_t rights = board.castlingRights();
+    if (((rights & (WhiteKingSide | WhiteQueenSide)) && !pieceOn(board, makeSquare(4, 0), PieceColor::White, PieceType::King))
+        || ((rights & WhiteKingSide) && !pieceOn(board, makeSquare(7, 0), PieceColor::White, PieceType::Rook))
+        || ((rights & WhiteQueenSide) && !pieceOn(board, makeSquare(0, 0), PieceColor::White, PieceType::Rook))
+        || ((rights & (BlackKingSide | BlackQueenSide)) && !pieceOn(board, makeSquare(4, 7), PieceColor::Black, PieceType::King))
+        || ((rights & BlackKingSide) && !pieceOn(board, makeSquare(7, 7), PieceColor::Black, PieceType::Rook))
+        || ((rights & BlackQueenSide) && !pieceOn(board, makeSquare(0, 7), PieceColor::Black, PieceType::Rook)))
+        return FenError::Castling;
+
+    const PieceColor us = board.sideToMove();
+    if (const int ep = board.enPassantSquare(); ep != NO_SQUARE)
+    {
+        // Le pion adverse vient de passer de sa 2e rangée (derrière la case) à sa 4e (devant) : case et départ vides
+        const int forward = us == PieceColor::White ? 8 : -8;
+        if (rankOf(ep) != (us == PieceColor::White ? 5 : 2) || !board.isEmpty(ep) || !board.isEmpty(ep + forward)
+            || !pieceOn(board, ep - forward, ~us, PieceType::Pawn))
+            return FenError::EnPassant;
+        if (!(Attacks::pawn(~us, ep) & board.pieces(us, PieceType::Pawn)))
+            board.setEnPassantSquare(NO_SQUARE);
+    }
+
+    if (board.attackersTo(board.kingSquare(~us), board.occupancy()) & board.occupancy(us))
+        return FenError::OpponentInCheck;
+    return FenError::None;
+}
+
+// Range une opération : les opérandes bruts vont de l'opcode au ';', sans les espaces autour ni les guillemets
+void addOperation(EpdRecord& record, std::string_view opcode, std::string_view operands)
+{
+    skipSpaces(operands);
+    while (!operands.empty() && (operands.back() == ' ' || operands.back() == '\t'))
+        operands.remove_suffix(1);
+    if (operands.size() >= 2 && operands.front() == '"' && operands.back() == '"')
+        operands = operands.substr(1, operands.size() - 2);
+
+    EpdOperation& operation = record.operations[record.count++];
+    operation.opcode        = opcode;
+    operation.operands      = operands;
+}
+
+// Opérations EPD : "opcode opérandes;" ; un ';' entre guillemets ne termine pas l'opération.
+// L'opcode s'arrête à la première espace, les opérandes au ';'
+// Découpage de référence, caractère par caractère : toujours utilisable, quelle que soit la longueur de la ligne
+FenError parseOperationsScalar(std::string_view line, EpdRecord& record)
+{
+    while (true)
+    {
+        skipSpaces(line);
+        if (line.empty() || line.front() == '\r' || line.front() == '\n')
+            break;
+        if (record.count == EpdRecord::MaxOperations)
+            return FenError::Operations;
+
+        size_t       opcodeLength = 0;
+        const size_t length       = operationLength(line, opcodeLength);
+        if (length == std::string_view::npos)
+            return FenError::Operations;
+        opcodeLength = std::min(length, opcodeLength);
+        addOperation(record, line.substr(0, opcodeLength), line.substr(opcodeLength, length - opcodeLength));
+        line.remove_prefix(length + 1);
+    }
+    return FenError::None;
+}
+
+FenError parseOperations(std::string_view line, const char* lineStart, EpdRecord& record)
+{
+#if FEN_SSE2
+    // Cas courant, au plus 64 octets d'opérations : les masques de toute la fin de ligne sont calculés d'un coup, et
+    // les bornes de toutes les opérations en découlent ensemble. Pour aller d'une position à la première suivante
+    // qui n'est pas dans un masque (la fin d'une suite d'espaces, d'un opcode), on ajoute le masque : la retenue
+    // traverse la suite et tombe sur la case voulue, une seule addition pour toutes les opérations
+    if (line.size() <= 64 && line.data() + line.size() - lineStart >= 16)
+    {
+        const CharMasks masks  = charMasks(line);
+        const uint64_t  valid  = line.size() == 64 ? ~0ULL : (1ULL << line.size()) - 1;
+        uint64_t        inside = masks.quotes; // bit i : nombre impair de '"' jusqu'à line[i] compris
+        for (int shift = 1; shift < 64; shift <<= 1)
+            inside ^= inside << shift;
+
+        uint64_t       ends        = masks.semicolons & ~inside;
+        const uint64_t opcodeChars = ~masks.blanks & ~ends & valid;
+        uint64_t       starts      = ((ends << 1 | 1) + masks.blanks) & ~masks.blanks & valid;
+        uint64_t       opcodeEnds  = (starts + opcodeChars) & ~opcodeChars;
+        uint64_t       operands    = (opcodeEnds + masks.blanks) & ~masks.blanks;
+
+        int count = record.count;
+        for (; starts; starts &= starts - 1, ends &= ends - 1, opcodeEnds &= opcodeEnds - 1, operands &= operands - 1)
+        {
+            const int start = std::countr_zero(starts);
+            if ((masks.lineEnds >> start) & 1)
+                break;
+            if (count == EpdRecord::MaxOperations || !ends)
+                return FenError::Operations;
+
+            // Opérandes : de la première à la dernière lettre avant le ';', sans les guillemets qui les entourent
+            const int      end   = std::countr_zero(ends);
+            int            first = std::countr_zero(operands);
+            const uint64_t word  = ~masks.blanks & ((1ULL << end) - 1) >> first << first;
+            int            last  = word ? 64 - std::countl_zero(word) : first;
+            if (last - first >= 2 && (masks.quotes >> first & 1) && (masks.quotes >> (last - 1) & 1))
+                ++first, --last;
+
+            EpdOperation& operation = record.operations[count++];
+            operation.opcode        = line.substr(start, std::countr_zero(opcodeEnds) - start);
+            operation.operands      = line.substr(first, last - first);
+        }
+        record.count = count;
+        return FenError::None;
+    }
+#else
+    (void)lineStart;
+#endif
+    return parseOperationsScalar(line, record);
+}
+
+// Placement seul, en remplissant out de gauche à droite
+char* writePosition(const BoardState& board, char* out)
+{
+    for (int rank = 7; rank >= 0; --rank)
+    {
+        int empty = 0;
+        for (int file = 0; file < 8; ++file)
+        {
+            const Piece piece = board.get(makeSquare(file, rank));
+            if (piece.type == PieceType::None)
+            {
+                ++empty;
+                continue;
+            }
+            if (empty)
+                *out++ = static_cast<char>('0' + empty);
+            empty = 0;
+            // Lettre majuscule pour les blancs, minuscule (+ 32 en ASCII) pour les noirs
+            *out++ = static_cast<char>(piece.toChar() + (piece.color == PieceColor::White ? 0 : 32));
+        }
+        if (empty)
+            *out++ = static_cast<char>('0' + empty);
+        if (rank > 0)
+            *out++ = '/';
+    }
+
+    *out++ = ' ';
+    *out++ = board.sideToMove() == PieceColor::White ? 'w' : 'b';
+    *out++ = ' ';
+
+    const uint8_t rights = board.castlingRights();
+    if (rights & WhiteKingSide)
+        *out++ = 'K';
+    if (rights & WhiteQueenSide)
+        *out++ = 'Q';
+    if (rights & BlackKingSide)
+        *out++ = 'k';
+    if (rights & BlackQueenSide)
+        *out++ = 'q';
+    if (!rights)
+        *out++ = '-';
+
+    *out++ = ' ';
+    if (const int ep = board.enPassantSquare(); ep == NO_SQUARE)
+        *out++ = '-';
+    else
+    {
+        *out++ = static_cast<char>('a' + fileOf(ep));
+        *out++ = static_cast<char>('1' + rankOf(ep));
+    }
+    return out;
+}
+
+// parseEpd et parseEpdScalar : seul le découpage des opérations change
+FenError readEpd(BoardState& board, std::string_view line, EpdRecord& record, bool fastOperations)
+{
+    record.count                = 0;
+    const char* const lineStart = line.data();
+    if (FenError error = parsePosition(board, line); error != FenError::None)
+        return error;
+
+    if (FenError error = fastOperations ? parseOperations(line, lineStart, record) : parseOperationsScalar(line, record);
+        error != FenError::None)
+        return error;
+
+    int halfmove = 0, fullmove = 1;
+    if (record.has("hmvc") && !parseNumber(record.operands("hmvc"), halfmove))
+        return FenError::Counters;
+    if (record.has("fmvn") && !parseNumber(record.operands("fmvn"), fullmove))
+        return FenError::Counters;
+    board.setMoveCounters(halfmove, std::max(fullmove, 1));
+
+    return validate(board);
+}
+
+} // namespace
+
+const char* fenErrorName(FenError error)
+{
+    switch (error)
+    {
+    case FenError::None: return "ok";
+    case FenError::Placement: return "invalid piece placement";
+    case FenError::SideToMove: return "invalid side to move";
+    case FenError::Castling: return "invalid castling rights";
+    case FenError::EnPassant: return "invalid en passant square";
+    case FenError::Counters: return "invalid move counters";
+    case FenError::Kings: return "each side needs exactly one king";
+    case FenError::Pawns: return "pawn on the first or last rank";
+    case FenError::OpponentInCheck: return "side not to move is in check";
+    case FenError::Operations: return "invalid EPD operations";
+    }
+    return "unknown error";
+}
+
+FenError parseFen(BoardState& board, std::string_view fen)
+{
+    if (FenError error = parsePosition(board, fen); error != FenError::None)
+        return error;
+
+    // Compteurs facultatifs (beaucoup de FEN s'arrêtent à la case en passant)
+    int halfmove = 0, fullmove = 1;
+    if (!readCounter(fen, halfmove) || !readCounter(fen, fullmove))
+        return FenError::Counters;
+    skipSpaces(fen);
+    if (!fen.empty())
+        return FenError::Counters;
+    board.setMoveCounters(halfmove, std::max(fullmove, 1));
+
+    return validate(board);
+}
+
+size_t writeFen(const BoardState& board, char* out)
+{
+    char* end = writePosition(board, out);
+    *end++    = ' ';
+    end       = std::to_chars(end, out + FEN_MAX_LENGTH, board.halfmoveClock()).ptr;
+    *end++    = ' ';
+    end       = std::to_chars(end, out + FEN_MAX_LENGTH, board.fullmoveNumber()).ptr;
+    return static_cast<size_t>(end - out);
+}
+
+std::string toFen(const BoardState& board)
+{
+    char buffer[FEN_MAX_LENGTH];
+    return std::string(buffer, writeFen(board, buffer));
+}
+
+// --- EPD ---
+
+std::string_view EpdRecord::operands(std::string_view opcode) const
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (operations[i].opcode == opcode)
+            return operations[i].operands;
+    }
+    return {};
+}
+
+bool EpdRecord::has(std::string_view opcode) const
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (operations[i].opcode == opcode)
+            return true;
+    }
+    return false;
+}
+
+FenError parseEpd(BoardState& board, std::string_view line, EpdRecord& record)
+{
+    return readEpd(board, line, record, true);
+}
+
+FenError parseEpdScalar(BoardState& board, std::string_view line, EpdRecord& record)
+{
+    return readEpd(board, line, record, false);
+}
+
+bool epdMoves(const BoardState& board, std::string_view operands, MoveList& moves)
+{
+    moves.clear();
+    while (true)
+    {
+        const std::string_view san = nextField(operands);
+        if (san.empty())
+            return !moves.empty();
+
+        const Move move = parseSan(board, san);
+        if (!move)
+            return false;
+        moves.push(move);
+    }
+}
+
+size_t writeEpd(const BoardState& board, char* out)
+{
+    return static_cast<size_t>(writePosition(board, out) - out);
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "BoardState.hpp"
+#include "Move.hpp"
+
+inline constexpr std::string_view START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// Pourquoi une FEN / EPD a été refusée
+enum class FenError {
+    None,
+    Placement,       // rangées mal formées (pas 8 rangées de 8 cases, caractère inconnu)
+    SideToMove,
+    Castling,        // droit de roque sans le roi et la tour sur leurs cases d'origine
+    EnPassant,       // case en passant impossible (mauvaise rangée, pas de pion qui vient d'avancer de deux cases)
+    Counters,        // compteurs de demi-coups / de coups illisibles
+    Kings,           // pas exactement un roi par camp
+    Pawns,           // pion sur la première ou la dernière rangée
+    OpponentInCheck, // le camp qui n'a pas le trait est en échec
+    Operations,      // EPD : opération mal formée ou trop d'opérations
+};
+
+const char* fenErrorName(FenError error);
+
+// Charge une position FEN (les deux compteurs sont facultatifs) et vérifie qu'elle est jouable.
+// Aucune allocation : tout est lu en place. En cas d'erreur, la position est dans un état quelconque.
+FenError parseFen(BoardState& board, std::string_view fen);
+inline bool loadFen(BoardState& board, std::string_view fen) { return parseFen(board, fen) == FenError::None; }
+
+// Une FEN fait au plus 71 + 1 + 1 + 1 + 4 + 1 + 2 + 2 x (1 + 10) caractères
+constexpr size_t FEN_MAX_LENGTH = 128;
+
+// Écrit la FEN dans out (au moins FEN_MAX_LENGTH octets, sans zéro final) et renvoie sa longueur
+size_t      writeFen(const BoardState& board, char* out);
+std::string toFen(const BoardState& board);
+
+// --- EPD ---
+// Les quatre premiers champs d'une FEN, puis des opérations "opcode opérandes;" : bm Nf3 Nc3; id "WAC.001";
+// Les opérations ne sont pas copiées : ce sont des vues dans la ligne, valides tant qu'elle l'est.
+struct EpdOperation {
+    std::string_view opcode;
+    std::string_view operands; // sans les guillemets d'une chaîne
+};
+
+struct EpdRecord {
+    static constexpr int MaxOperations = 16;
+
+    std::array<EpdOperation, MaxOperations> operations{};
+    int                                     count = 0;
+
+    // Opérandes de l'opération (vide si elle est absente)
+    std::string_view operands(std::string_view opcode) const;
+    bool             has(std::string_view opcode) const;
+
+    std::string_view id() const { return operands("id"); }
+};
+
+// hmvc et fmvn, s'ils sont présents, donnent les compteurs de la position
+FenError parseEpd(BoardState& board, std::string_view line, EpdRecord& record);
+
+// Comme parseEpd, mais les opérations sont toujours découpées caractère par caractère. parseEpd passe par un
+// découpage SSE2 quand elles tiennent en 64 octets : c'est la référence à laquelle epd --parse le compare
+FenError parseEpdScalar(BoardState& board, std::string_view line, EpdRecord& record);
+
+// Coups (en SAN, séparés par des espaces) des opérandes de bm / am ; false si l'un d'eux n'est pas légal
+bool epdMoves(const BoardState& board, std::string_view operands, MoveList& moves);
+
+// Écrit les quatre champs de position d'une EPD (sans opérations) ; même contrat que writeFen
+size_t writeEpd(const BoardState& board, char* out);
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief Fichier projeté en mémoire, en lecture seule.
+ *
+ * Le contenu est lu directement depuis les pages du système : pas de copie, pas de tampon, et un fichier de
+ * plusieurs gigaoctets ne coûte que l'espace d'adressage. Les vues renvoyées restent valides tant que l'objet vit.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // false si le fichier ne peut pas être ouvert ; un fichier vide s'ouvre mais sa vue est vide
+    bool open(const std::string& path);
+    void close();
+
+    bool             isOpen() const { return m_open; }
+    std::string_view view() const { return {m_data, m_size}; }
+    size_t           size() const { return m_size; }
+
+    // Prévient le système que le fichier sera lu du début à la fin (lecture anticipée plus agressive)
+    void adviseSequential() const;
+
+private:
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+    bool        m_open = false;
+#ifdef _WIN32
+    void* m_file    = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
@@ -0,0 +1,20 @@
+#include "Move.hpp"
+
+std::string squareName(int sq)
+{
+    return {static_cast<char>('a' + fileOf(sq)), static_cast<char>('1' + rankOf(sq))};
+}
+
+std::string moveToUci(Move move)
+{
+    if (!move)
+        return "0000";
+
+    std::string text = squareName(move.from()) + squareName(move.to());
+    if (move.isPromotion())
+    {
+        constexpr char suffix[4] = {'n', 'b', 'r', 'q'};
+        text += suffix[move.flags() & 3];
+    }
+    return text;
+}
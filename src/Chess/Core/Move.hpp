@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Bitboard.hpp"
+
+// Type de coup stocké dans les 4 bits de poids fort
+enum MoveFlag : uint16_t {
+    Quiet          = 0,
+    DoublePawnPush = 1,
+    KingCastle     = 2,
+    QueenCastle    = 3,
+    Capture        = 4,
+    EnPassant      = 5,
+    Promotion      = 8, // + 0..3 pour Cavalier, Fou, Tour, Dame ; + Capture si la promotion prend
+};
+
+// Coup encodé sur 16 bits : départ (6 bits) | arrivée (6 bits) << 6 | type (4 bits) << 12
+// Comme un int, un Move construit par défaut n'est pas initialisé (les MoveList ne paient pas de mise à zéro) :
+// utiliser Move::none() pour un coup "vide".
+class Move {
+public:
+    Move() = default;
+    constexpr Move(int from, int to, int flags = Quiet)
+        : m_data(static_cast<uint16_t>(from | (to << 6) | (flags << 12))) {}
+
+    static constexpr Move none() { return Move(0, 0); }
+    static constexpr Move fromRaw(uint16_t raw)
+    {
+        Move m(0, 0);
+        m.m_data = raw;
+        return m;
+    }
+
+    constexpr int      from() const { return m_data & 0x3F; }
+    constexpr int      to() const { return (m_data >> 6) & 0x3F; }
+    constexpr int      flags() const { return m_data >> 12; }
+    constexpr uint16_t raw() const { return m_data; }
+
+    constexpr bool isCapture() const { return (flags() & Capture) != 0; }
+    constexpr bool isPromotion() const { return (flags() & Promotion) != 0; }
+    constexpr bool isEnPassant() const { return flags() == EnPassant; }
+    constexpr bool isCastling() const { return flags() == KingCastle || flags() == QueenCastle; }
+
+    constexpr PieceType promotionType() const
+    {
+        constexpr PieceType types[4] = {PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen};
+        return types[flags() & 3];
+    }
+
+    constexpr bool operator==(const Move& other) const { return m_data == other.m_data; }
+    constexpr bool operator!=(const Move& other) const { return m_data != other.m_data; }
+    constexpr explicit operator bool() const { return m_data != 0; }
+
+private:
+    uint16_t m_data;
+};
+
+constexpr int promotionFlag(PieceType type)
+{
+    switch (type)
+    {
+    case PieceType::Knight: return Promotion | 0;
+    case PieceType::Bishop: return Promotion | 1;
+    case PieceType::Rook: return Promotion | 2;
+    default: return Promotion | 3;
+    }
+}
+
+// Notation "longue" des coups (e2e4, e7e8q), celle du protocole UCI
+std::string squareName(int sq);
+std::string moveToUci(Move move);
+
+// Liste de coups à capacité fixe, sur la pile : aucune allocation pendant la génération
+class MoveList {
+public:
+    static constexpr size_t Capacity = 256; // le maximum connu pour une position légale est 218
+
+    void push(Move move) { m_moves[m_size++] = move; }
+    void clear() { m_size = 0; }
+
+    size_t size() const { return m_size; }
+    bool   empty() const { return m_size == 0; }
+    Move   operator[](size_t i) const { return m_moves[i]; }
+    Move&  operator[](size_t i) { return m_moves[i]; }
+
+    const Move* begin() const { return m_moves; }
+    const Move* end() const { return m_moves + m_size; }
+    Move*       begin() { return m_moves; }
+    Move*       end() { return m_moves + m_size; }
+
+    bool contains(Move move) const
+    {
+        for (Move m : *this)
+        {
+            if (m == move)
+                return true;
+        }
+        return false;
+    }
+
+private:
+    Move   m_moves[Capacity];
+    size_t m_size = 0;
+};
@@ -0,0 +1,255 @@
+#include "MoveGen.hpp"
+
+namespace {
+
+inline void pushTargets(MoveList& moves, int from, Bitboard targets, Bitboard enemies)
+{
+    while (targets)
+    {
+        int to = popLsb(targets);
+        moves.push(Move(from, to, (enemies & squareBB(to)) ? Capture : Quiet));
+    }
+}
+
+inline void pushPromotions(MoveList& moves, int from, int to, bool capture)
+{
+    const int captureFlag = capture ? Capture : 0;
+    moves.push(Move(from, to, promotionFlag(PieceType::Queen) | captureFlag));
+    moves.push(Move(from, to, promotionFlag(PieceType::Rook) | captureFlag));
+    moves.push(Move(from, to, promotionFlag(PieceType::Bishop) | captureFlag));
+    moves.push(Move(from, to, promotionFlag(PieceType::Knight) | captureFlag));
+}
+
+// Cases attaquées par le camp "by" ; le roi adverse est retiré de l'occupation pour qu'il ne puisse pas
+// reculer le long du rayon d'une pièce qui le met en échec
+bool isAttacked(const BoardState& board, int sq, PieceColor by, Bitboard occupied)
+{
+    return (board.attackersTo(sq, occupied) & board.occupancy(by)) != 0;
+}
+
+template <GenType Type>
+void generatePawnMoves(const BoardState& board, MoveList& moves, Bitboard fromMask, Bitboard targetMask, Bitboard pinned, int ksq)
+{
+    const PieceColor us       = board.sideToMove();
+    const PieceColor them     = ~us;
+    const Bitboard   enemies  = board.occupancy(them);
+    const Bitboard   empty    = ~board.occupancy();
+    const int        forward  = (us == PieceColor::White) ? 8 : -8;
+    const Bitboard   lastRank = (us == PieceColor::White) ? RANK_8_BB : RANK_1_BB;
+    const Bitboard   thirdRank = (us == PieceColor::White) ? (RANK_2_BB << 8) : (RANK_7_BB >> 8);
+
+    Bitboard pawns = board.pieces(us, PieceType::Pawn) & fromMask;
+    while (pawns)
+    {
+        const int from = popLsb(pawns);
+        // Un pion cloué ne peut bouger que le long de la ligne qui le relie à son roi
+        const Bitboard allowed = (pinned & squareBB(from)) ? Attacks::line(ksq, from) : ~0ULL;
+
+        // Poussées
+        const int single = from + forward;
+        if (single >= 0 && single < 64 && (empty & squareBB(single)))
+        {
+            if (targetMask & allowed & squareBB(single))
+            {
+                if (squareBB(single) & lastRank)
+                {
+                    if constexpr (Type != GenType::Quiets)
+                        pushPromotions(moves, from, single, false);
+                }
+                else if constexpr (Type != GenType::Captures)
+                    moves.push(Move(from, single, Quiet));
+            }
+
+            const int doubleSq = single + forward;
+            if constexpr (Type != GenType::Captures)
+            {
+                if ((squareBB(single) & thirdRank) && (empty & squareBB(doubleSq)) && (targetMask & allowed & squareBB(doubleSq)))
+                    moves.push(Move(from, doubleSq, DoublePawnPush));
+            }
+        }
+
+        if constexpr (Type == GenType::Quiets)
+            continue;
+
+        // Prises
+        Bitboard captures = Attacks::pawn(us, from) & enemies & targetMask & allowed;
+        while (captures)
+        {
+            const int to = popLsb(captures);
+            if (squareBB(to) & lastRank)
+                pushPromotions(moves, from, to, true);
+            else
+                moves.push(Move(from, to, Capture));
+        }
+
+        // Prise en passant : on rejoue la prise sur l'occupation pour détecter les clouages "horizontaux"
+        // (les deux pions quittent la même rangée) et les échecs qu'elle ne pare pas
+        const int ep = board.enPassantSquare();
+        if (ep != NO_SQUARE && (Attacks::pawn(us, from) & squareBB(ep)))
+        {
+            const int captured = ep - forward;
+            if (ksq == NO_SQUARE)
+            {
+                moves.push(Move(from, ep, EnPassant));
+                continue;
+            }
+            Bitboard occupied = (board.occupancy() ^ squareBB(from) ^ squareBB(captured)) | squareBB(ep);
+            Bitboard attackers = board.attackersTo(ksq, occupied) & enemies & ~squareBB(captured);
+            if (!attackers)
+                moves.push(Move(from, ep, EnPassant));
+        }
+    }
+}
+
+void generateCastling(const BoardState& board, MoveList& moves, int ksq)
+{
+    const PieceColor us     = board.sideToMove();
+    const PieceColor them   = ~us;
+    const int        rank   = (us == PieceColor::White) ? 0 : 7;
+    const uint8_t    rights = board.castlingRights() & (us == PieceColor::White ? (WhiteKingSide | WhiteQueenSide) : (BlackKingSide | BlackQueenSide));
+    const Bitboard   rooks  = board.pieces(us, PieceType::Rook);
+
+    if (!rights || ksq != makeSquare(4, rank))
+        return;
+
+    const Bitboard occupied = board.occupancy();
+
+    // Petit roque : f et g vides, et ni e, ni f, ni g attaquées (e est déjà vérifiée : pas d'échec)
+    if ((rights & (WhiteKingSide | BlackKingSide)) && (rooks & squareBB(makeSquare(7, rank)))
+        && !(occupied & (squareBB(makeSquare(5, rank)) | squareBB(makeSquare(6, rank))))
+        && !isAttacked(board, makeSquare(5, rank), them, occupied) && !isAttacked(board, makeSquare(6, rank), them, occupied))
+    {
+        moves.push(Move(ksq, makeSquare(6, rank), KingCastle));
+    }
+
+    // Grand roque : b, c et d vides, seules c et d ne doivent pas être attaquées
+    if ((rights & (WhiteQueenSide | BlackQueenSide)) && (rooks & squareBB(makeSquare(0, rank)))
+        && !(occupied & (squareBB(makeSquare(1, rank)) | squareBB(makeSquare(2, rank)) | squareBB(makeSquare(3, rank))))
+        && !isAttacked(board, makeSquare(3, rank), them, occupied) && !isAttacked(board, makeSquare(2, rank), them, occupied))
+    {
+        moves.push(Move(ksq, makeSquare(2, rank), QueenCastle));
+    }
+}
+
+template <GenType Type>
+void generate(const BoardState& board, MoveList& moves, Bitboard fromMask)
+{
+    moves.clear();
+
+    const PieceColor us       = board.sideToMove();
+    const PieceColor them     = ~us;
+    const Bitboard   ours     = board.occupancy(us);
+    const Bitboard   enemies  = board.occupancy(them);
+    const Bitboard   occupied = board.occupancy();
+    const int        ksq      = board.kingSquare(us);
+
+    // Cases d'arrivée autorisées par le type de génération
+    const Bitboard typeMask = Type == GenType::Captures ? enemies : Type == GenType::Quiets ? ~enemies : ~0ULL;
+
+    Bitboard checkers    = 0;
+    Bitboard pinned      = 0;
+    Bitboard evasionMask = ~ours; // en échec : prendre la pièce qui donne échec ou s'interposer
+
+    if (ksq != NO_SQUARE)
+    {
+        checkers = board.attackersTo(ksq, occupied) & enemies;
+
+        // Coups du roi : la case d'arrivée ne doit pas être attaquée une fois le roi parti
+        Bitboard kingTargets = (fromMask & squareBB(ksq)) ? Attacks::king(ksq) & ~ours & typeMask : 0;
+        while (kingTargets)
+        {
+            const int to = popLsb(kingTargets);
+            if (!isAttacked(board, to, them, occupied ^ squareBB(ksq)))
+                moves.push(Move(ksq, to, (enemies & squareBB(to)) ? Capture : Quiet));
+        }
+
+        // Échec double : seul le roi peut bouger
+        if (moreThanOne(checkers))
+            return;
+
+        // Échec simple : il faut prendre la pièce qui donne échec ou s'interposer
+        if (checkers)
+            evasionMask &= Attacks::between(ksq, lsb(checkers)) | checkers;
+
+        // Pièces clouées : une seule de nos pièces entre le roi et une pièce glissante adverse
+        Bitboard snipers = (Attacks::rook(ksq, 0) & (board.pieces(them, PieceType::Rook) | board.pieces(them, PieceType::Queen)))
+                           | (Attacks::bishop(ksq, 0) & (board.pieces(them, PieceType::Bishop) | board.pieces(them, PieceType::Queen)));
+        while (snipers)
+        {
+            const Bitboard blockers = Attacks::between(ksq, popLsb(snipers)) & occupied;
+            if (blockers && !moreThanOne(blockers) && (blockers & ours))
+                pinned |= blockers;
+        }
+    }
+
+    // Les pions trient eux-mêmes leurs coups par type : une promotion sans prise compte parmi les prises
+    generatePawnMoves<Type>(board, moves, fromMask, evasionMask, pinned, ksq);
+
+    const Bitboard targetMask = evasionMask & typeMask;
+
+    // Cavaliers : un cavalier cloué ne peut jamais bouger
+    Bitboard knights = board.pieces(us, PieceType::Knight) & ~pinned & fromMask;
+    while (knights)
+    {
+        const int from = popLsb(knights);
+        pushTargets(moves, from, Attacks::knight(from) & targetMask, enemies);
+    }
+
+    for (PieceType type : {PieceType::Bishop, PieceType::Rook, PieceType::Queen})
+    {
+        Bitboard sliders = board.pieces(us, type) & fromMask;
+        while (sliders)
+        {
+            const int from    = popLsb(sliders);
+            Bitboard  targets = Attacks::attacks(type, from, occupied) & targetMask;
+            if (pinned & squareBB(from))
+                targets &= Attacks::line(ksq, from);
+            pushTargets(moves, from, targets, enemies);
+        }
+    }
+
+    if constexpr (Type != GenType::Captures)
+    {
+        if (!checkers && ksq != NO_SQUARE && (fromMask & squareBB(ksq)))
+            generateCastling(board, moves, ksq);
+    }
+}
+
+} // namespace
+
+void generateLegalMoves(const BoardState& board, MoveList& moves, GenType type)
+{
+    switch (type)
+    {
+    case GenType::Captures: generate<GenType::Captures>(board, moves, ~0ULL); break;
+    case GenType::Quiets: generate<GenType::Quiets>(board, moves, ~0ULL); break;
+    default: generate<GenType::All>(board, moves, ~0ULL); break;
+    }
+}
+
+void generateLegalMoves(const BoardState& board, MoveList& moves, Bitboard fromMask)
+{
+    generate<GenType::All>(board, moves, fromMask);
+}
+
+bool isLegal(const BoardState& board, Move move)
+{
+    if (!move || board.isEmpty(move.from()))
+        return false;
+
+    MoveList moves;
+    generate<GenType::All>(board, moves, squareBB(move.from()));
+    return moves.contains(move);
+}
+
+Move findLegalMove(const BoardState& board, int from, int to, PieceType promotion)
+{
+    MoveList moves;
+    generateLegalMoves(board, moves);
+    for (Move move : moves)
+    {
+        if (move.from() == from && move.to() == to && (!move.isPromotion() || move.promotionType() == promotion))
+            return move;
+    }
+    return Move::none();
+}
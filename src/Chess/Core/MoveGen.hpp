@@ -0,0 +1,24 @@
+#pragma once
+#include "BoardState.hpp"
+#include "Move.hpp"
+
+// Sélection des coups générés : de quoi produire d'abord les prises, puis les coups calmes seulement si besoin
+enum class GenType {
+    Captures, // prises, prises en passant et toutes les promotions
+    Quiets,   // tout le reste, roques compris
+    All,
+};
+
+// Génère tous les coups légaux de la position (clouages, parades d'échec, en passant, promotions, roques).
+// Tout se fait sur la pile : aucune allocation par appel.
+void generateLegalMoves(const BoardState& board, MoveList& moves, GenType type = GenType::All);
+
+// Seulement les coups légaux des pièces posées sur fromMask (lecture de la SAN : on sait déjà quelle pièce bouge)
+void generateLegalMoves(const BoardState& board, MoveList& moves, Bitboard fromMask);
+
+// Le coup (venu d'une table, d'un autre noeud...) est-il légal dans cette position ?
+// Seuls les coups de la pièce de départ sont générés.
+bool isLegal(const BoardState& board, Move move);
+
+// Cherche le coup légal correspondant à un déplacement (from -> to) ; pour une promotion, la dame par défaut
+Move findLegalMove(const BoardState& board, int from, int to, PieceType promotion = PieceType::Queen);
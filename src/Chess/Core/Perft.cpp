@@ -0,0 +1,163 @@
+#include "Perft.hpp"
+#include <algorithm>
+#include <bit>
+#include "../../utils/ThreadPool.hpp"
+#include "MoveGen.hpp"
+
+namespace {
+
+// Une seule position pour tout l'arbre : on joue, on descend, on défait
+uint64_t perftRecursive(BoardState& board, int depth)
+{
+    MoveList moves;
+    generateLegalMoves(board, moves);
+    if (depth <= 1)
+        return depth == 1 ? moves.size() : 1;
+
+    uint64_t nodes = 0;
+    for (Move move : moves)
+    {
+        board.makeMove(move);
+        nodes += perftRecursive(board, depth - 1);
+        board.unmakeMove();
+    }
+    return nodes;
+}
+
+} // namespace
+
+uint64_t perft(const BoardState& board, int depth)
+{
+    BoardState work = board;
+    return perftRecursive(work, depth);
+}
+
+std::vector<PerftDivideEntry> perftDivide(const BoardState& board, int depth)
+{
+    BoardState work = board;
+    MoveList   moves;
+    generateLegalMoves(work, moves);
+
+    std::vector<PerftDivideEntry> entries;
+    entries.reserve(moves.size());
+    for (Move move : moves)
+    {
+        work.makeMove(move);
+        entries.push_back({move, perftRecursive(work, depth - 1)});
+        work.unmakeMove();
+    }
+    return entries;
+}
+
+PerftHashTable::PerftHashTable(size_t megabytes)
+{
+    // Nombre d'entrées arrondi à la puissance de 2 inférieure pour indexer par masque
+    size_t count = std::bit_floor(std::max<size_t>(megabytes * 1024 * 1024 / sizeof(Entry), 1));
+    m_entries    = std::make_unique<Entry[]>(count);
+    m_mask       = count - 1;
+}
+
+bool PerftHashTable::probe(uint64_t key, int depth, uint64_t& nodes) const
+{
+    const Entry&   entry = m_entries[key & m_mask];
+    const uint64_t data  = entry.data.load(std::memory_order_relaxed);
+    const uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != key || static_cast<int>(data & 0xFF) != depth)
+        return false;
+
+    nodes = data >> 8;
+    return true;
+}
+
+void PerftHashTable::store(uint64_t key, int depth, uint64_t nodes)
+{
+    Entry&         entry = m_entries[key & m_mask];
+    const uint64_t data  = (nodes << 8) | static_cast<uint64_t>(depth);
+    entry.data.store(data, std::memory_order_relaxed);
+    entry.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+namespace {
+
+uint64_t perftHashed(BoardState& board, int depth, PerftHashTable& hash)
+{
+    MoveList moves;
+    generateLegalMoves(board, moves);
+    if (depth <= 1)
+        return depth == 1 ? moves.size() : 1;
+
+    const uint64_t key = board.key();
+    uint64_t       nodes;
+    if (hash.probe(key, depth, nodes))
+        return nodes;
+
+    nodes = 0;
+    for (Move move : moves)
+    {
+        board.makeMove(move);
+        nodes += perftHashed(board, depth - 1, hash);
+        board.unmakeMove();
+    }
+    hash.store(key, depth, nodes);
+    return nodes;
+}
+
+} // namespace
+
+uint64_t perftParallel(const BoardState& board, int depth, const PerftOptions& options, std::vector<PerftDivideEntry>* divide)
+{
+    // Profondeur nulle : la position elle-même, aucun coup racine à détailler (comme perftRecursive)
+    if (depth <= 0)
+        return 1;
+
+    std::unique_ptr<PerftHashTable> hash;
+    if (options.hashMegabytes > 0)
+        hash = std::make_unique<PerftHashTable>(options.hashMegabytes);
+
+    MoveList rootMoves;
+    generateLegalMoves(board, rootMoves);
+
+    // Un compteur par coup racine, alimenté par toutes les tâches de son sous-arbre
+    std::vector<std::atomic<uint64_t>> counts(rootMoves.size());
+    {
+        ThreadPool pool(options.threads);
+        BoardState child = board;
+        for (size_t i = 0; i < rootMoves.size(); ++i)
+        {
+            child.makeMove(rootMoves[i]);
+            if (depth <= 2)
+            {
+                counts[i] = perftRecursive(child, depth - 1);
+                child.unmakeMove();
+                continue;
+            }
+
+            // Découpe au 2e demi-coup : assez de tâches pour occuper tous les coeurs,
+            // le vol de tâches se charge d'équilibrer les sous-arbres de tailles très différentes
+            MoveList replies;
+            generateLegalMoves(child, replies);
+            // Chaque tâche reçoit sa propre copie de la position, qu'elle joue et défait ensuite sur place
+            for (Move reply : replies)
+            {
+                child.makeMove(reply);
+                pool.submit([grandChild = child, depth, &hash, &counts, i]() mutable {
+                    uint64_t nodes = hash ? perftHashed(grandChild, depth - 2, *hash) : perftRecursive(grandChild, depth - 2);
+                    counts[i].fetch_add(nodes, std::memory_order_relaxed);
+                });
+                child.unmakeMove();
+            }
+            child.unmakeMove();
+        }
+        pool.wait();
+    }
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < rootMoves.size(); ++i)
+    {
+        const uint64_t nodes = counts[i].load();
+        total += nodes;
+        if (divide)
+            divide->push_back({rootMoves[i], nodes});
+    }
+    return total;
+}
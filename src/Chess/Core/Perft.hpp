@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "BoardState.hpp"
+#include "Move.hpp"
+
+// Compte les feuilles de l'arbre des coups légaux à la profondeur donnée.
+// Le dernier niveau n'est pas joué : la taille de la liste suffit ("bulk counting").
+// L'arbre est parcouru sur une seule copie de la position, en makeMove / unmakeMove.
+uint64_t perft(const BoardState& board, int depth);
+
+struct PerftDivideEntry {
+    Move     move;
+    uint64_t nodes;
+};
+
+// Même chose, détaillé coup par coup à la racine (pour comparer avec un autre moteur)
+std::vector<PerftDivideEntry> perftDivide(const BoardState& board, int depth);
+
+// Table partagée (sans verrou) des comptes de sous-arbres, indexée par la signature de la position.
+// Chaque entrée garde clé ^ donnée et la donnée : une écriture concurrente "déchirée" ne passe pas la vérification.
+class PerftHashTable {
+public:
+    explicit PerftHashTable(size_t megabytes);
+
+    bool probe(uint64_t key, int depth, uint64_t& nodes) const;
+    void store(uint64_t key, int depth, uint64_t nodes);
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> check{0}; // clé ^ donnée
+        std::atomic<uint64_t> data{0};  // noeuds << 8 | profondeur
+    };
+
+    std::unique_ptr<Entry[]> m_entries;
+    uint64_t                 m_mask = 0;
+};
+
+struct PerftOptions {
+    unsigned threads       = 1;
+    size_t   hashMegabytes = 0; // 0 = pas de table
+};
+
+// Perft parallèle : chaque sous-arbre du 2e demi-coup devient une tâche d'un pool à vol de tâches.
+// Si divide n'est pas nul, il reçoit le détail par coup à la racine.
+uint64_t perftParallel(const BoardState& board, int depth, const PerftOptions& options, std::vector<PerftDivideEntry>* divide = nullptr);
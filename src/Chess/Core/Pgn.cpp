@@ -0,0 +1,414 @@
+#include "Pgn.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include "Fen.hpp"
+#include "San.hpp"
+
+namespace {
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// Fin de la ligne qui commence à pos (après le '\n', ou la fin du texte)
+size_t lineEnd(std::string_view data, size_t pos)
+{
+    const size_t newline = data.find('\n', pos);
+    return newline == std::string_view::npos ? data.size() : newline + 1;
+}
+
+// [Nom "Valeur"] ; false si la ligne n'a pas cette forme
+bool parseTag(std::string_view line, PgnTag& tag)
+{
+    size_t pos = 1; // après le '['
+    while (pos < line.size() && isSpace(line[pos]))
+        ++pos;
+    const size_t nameStart = pos;
+    while (pos < line.size() && !isSpace(line[pos]) && line[pos] != '"')
+        ++pos;
+    tag.name = line.substr(nameStart, pos - nameStart);
+    while (pos < line.size() && isSpace(line[pos]))
+        ++pos;
+    if (tag.name.empty() || pos == line.size() || line[pos] != '"')
+        return false;
+
+    const size_t valueStart = ++pos;
+    while (pos < line.size() && line[pos] != '"')
+        pos += line[pos] == '\\' ? 2 : 1;
+    if (pos >= line.size())
+        return false;
+    tag.value = line.substr(valueStart, pos - valueStart);
+    return true;
+}
+
+// Saute un commentaire {...} ou une variante (...) qui commence à pos ; npos s'il n'est jamais refermé.
+// Les variantes peuvent s'imbriquer et contenir des commentaires (eux-mêmes avec des parenthèses).
+size_t skipAnnotation(std::string_view text, size_t pos)
+{
+    if (text[pos] == '{')
+    {
+        const size_t end = text.find('}', pos + 1);
+        return end == std::string_view::npos ? end : end + 1;
+    }
+
+    int depth = 0;
+    while (pos < text.size())
+    {
+        const char c = text[pos];
+        if (c == '{')
+        {
+            pos = text.find('}', pos + 1);
+            if (pos == std::string_view::npos)
+                return pos;
+        }
+        else if (c == ';')
+        {
+            pos = text.find('\n', pos + 1);
+            if (pos == std::string_view::npos)
+                return pos;
+        }
+        else if (c == '(')
+            ++depth;
+        else if (c == ')' && --depth == 0)
+            return pos + 1;
+        ++pos;
+    }
+    return std::string_view::npos;
+}
+
+// Fin des coups qui commencent à pos (en début de ligne) : la première ligne qui commence par '[' hors de tout
+// commentaire, data.size() s'il n'y en a pas. Une ligne de commentaire {...} peut commencer par '[' ("[%clk ...]}").
+// Un '{' jamais refermé ne peut pas appartenir à une partie valide : on revient alors à la première ligne '['
+// qui le suit, pour qu'il n'avale pas les parties suivantes
+size_t movetextEnd(std::string_view data, size_t pos)
+{
+    bool lineStart = true;
+    while (pos < data.size())
+    {
+        const char c = data[pos];
+        if (lineStart && c == '[')
+            return pos;
+        lineStart = c == '\n';
+        if (c == ';')
+        {
+            pos       = lineEnd(data, pos);
+            lineStart = true;
+            continue;
+        }
+        if (c == '{')
+        {
+            const size_t close = data.find('}', pos + 1);
+            if (close == std::string_view::npos)
+            {
+                const size_t tag = data.find("\n[", pos);
+                return tag == std::string_view::npos ? data.size() : tag + 1;
+            }
+            pos = close;
+        }
+        ++pos;
+    }
+    return data.size();
+}
+
+bool isTokenEnd(char c)
+{
+    return isSpace(c) || c == '{' || c == '(' || c == ')' || c == ';';
+}
+
+} // namespace
+
+std::string_view resultToPgn(GameResult result)
+{
+    switch (result)
+    {
+    case GameResult::WhiteWins: return "1-0";
+    case GameResult::BlackWins: return "0-1";
+    case GameResult::Draw: return "1/2-1/2";
+    default: return "*";
+    }
+}
+
+GameResult resultFromPgn(std::string_view text)
+{
+    if (text == "1-0")
+        return GameResult::WhiteWins;
+    if (text == "0-1")
+        return GameResult::BlackWins;
+    if (text == "1/2-1/2")
+        return GameResult::Draw;
+    return GameResult::Unknown;
+}
+
+std::string_view PgnGame::tag(std::string_view name) const
+{
+    for (int i = 0; i < tagCount; ++i)
+    {
+        if (tags[i].name == name)
+            return tags[i].value;
+    }
+    return {};
+}
+
+bool PgnReader::next(PgnGame& game)
+{
+    // Lignes vides, BOM UTF-8 en tête de fichier, et tout ce qui précède la première ligne de tag
+    if (m_pos == 0 && m_data.substr(0, 3) == "\xEF\xBB\xBF")
+        m_pos = 3;
+    while (m_pos < m_data.size() && isSpace(m_data[m_pos]))
+        ++m_pos;
+    if (m_pos >= m_data.size())
+        return false;
+
+    const size_t start = m_pos;
+    game.offset        = start;
+    game.tagCount      = 0;
+    while (m_pos < m_data.size() && m_data[m_pos] == '[')
+    {
+        const size_t end = lineEnd(m_data, m_pos);
+        PgnTag       tag;
+        if (parseTag(m_data.substr(m_pos, end - m_pos), tag) && game.tagCount < PgnGame::MaxTags)
+            game.tags[game.tagCount++] = tag;
+        m_pos = end;
+        while (m_pos < m_data.size() && isSpace(m_data[m_pos]))
+            ++m_pos;
+    }
+
+    // Les coups : jusqu'à la prochaine ligne de tag (hors commentaires)
+    const size_t movesStart = m_pos;
+    m_pos                   = movetextEnd(m_data, m_pos);
+
+    size_t movesEnd = m_pos;
+    while (movesEnd > movesStart && isSpace(m_data[movesEnd - 1]))
+        --movesEnd;
+    game.movetext = m_data.substr(movesStart, movesEnd - movesStart);
+    game.text     = m_data.substr(start, movesEnd - start);
+    return true;
+}
+
+size_t nextGameStart(std::string_view data, size_t from)
+{
+    if (from == 0)
+        return 0;
+
+    // Un '[' en début de ligne peut être dans un commentaire : on ne sait où l'on est qu'en relisant depuis un début
+    // de partie sûr. On recule jusqu'à une vraie ligne de tag, puis on avance partie par partie comme PgnReader
+    size_t pos = from;
+    do
+    {
+        const size_t previous = pos >= 2 ? data.rfind('\n', pos - 2) : std::string_view::npos;
+        pos                   = previous == std::string_view::npos ? 0 : previous + 1;
+        PgnTag tag;
+        if (data[pos] == '[' && parseTag(data.substr(pos, lineEnd(data, pos) - pos), tag))
+            break;
+    } while (pos > 0);
+
+    while (pos < data.size())
+    {
+        while (pos < data.size() && data[pos] == '[')
+        {
+            pos = lineEnd(data, pos);
+            while (pos < data.size() && isSpace(data[pos]))
+                ++pos;
+        }
+        pos = movetextEnd(data, pos);
+        if (pos >= from)
+            return pos;
+    }
+    return data.size();
+}
+
+const char* pgnErrorName(PgnError error)
+{
+    switch (error)
+    {
+    case PgnError::None: return "ok";
+    case PgnError::Fen: return "invalid FEN tag";
+    case PgnError::IllegalMove: return "illegal move";
+    case PgnError::Syntax: return "unterminated comment or variation";
+    }
+    return "unknown error";
+}
+
+PgnError replayGame(const PgnGame& game, BoardState& board, ReplayedGame& replay)
+{
+    replay.moves.clear();
+    replay.result     = resultFromPgn(game.tag("Result"));
+    replay.errorToken = {};
+
+    const std::string_view fen = game.tag("FEN");
+    if (parseFen(replay.start, fen.empty() ? START_FEN : fen) != FenError::None)
+        return PgnError::Fen;
+    board = replay.start;
+
+    const std::string_view text = game.movetext;
+    size_t                 pos  = 0;
+    while (pos < text.size())
+    {
+        const char c = text[pos];
+        if (isSpace(c) || c == ')')
+        {
+            ++pos;
+            continue;
+        }
+        if (c == '{' || c == '(')
+        {
+            pos = skipAnnotation(text, pos);
+            if (pos == std::string_view::npos)
+                return PgnError::Syntax;
+            continue;
+        }
+        if (c == ';' || c == '%') // commentaire ou échappement jusqu'à la fin de la ligne
+        {
+            pos = lineEnd(text, pos);
+            continue;
+        }
+
+        size_t end = pos;
+        while (end < text.size() && !isTokenEnd(text[end]))
+            ++end;
+        std::string_view token = text.substr(pos, end - pos);
+        pos                    = end;
+
+        if (token.front() == '$') // NAG : $1, $14...
+            continue;
+        if (token == "*" || token == "1-0" || token == "0-1" || token == "1/2-1/2")
+        {
+            replay.result = resultFromPgn(token);
+            continue;
+        }
+
+        // Numéro de coup ("12." ou "12...") éventuellement collé au coup ("12.e4") ; "0-0" est un roque
+        if (isDigit(token.front()))
+        {
+            size_t digits = 0;
+            while (digits < token.size() && isDigit(token[digits]))
+                ++digits;
+            if (digits < token.size() && token[digits] == '.')
+            {
+                while (digits < token.size() && token[digits] == '.')
+                    ++digits;
+                token.remove_prefix(digits);
+                if (token.empty())
+                    continue;
+            }
+        }
+
+        const Move move = parseSan(board, token);
+        if (!move)
+        {
+            replay.errorToken = token;
+            return PgnError::IllegalMove;
+        }
+        replay.moves.push_back(move);
+        board.makeMove(move);
+    }
+    return PgnError::None;
+}
+
+// --- Écriture ---
+
+namespace {
+
+constexpr int PGN_LINE_LENGTH = 79;
+
+} // namespace
+
+PgnWriter::PgnWriter(std::FILE* file, size_t bufferSize) : m_file(file), m_threshold(std::max<size_t>(bufferSize, 4096))
+{
+    m_buffer.resize(m_threshold + 4096);
+}
+
+void PgnWriter::append(std::string_view text)
+{
+    // Une partie plus grosse que le tampon le fait grandir (rare) : on ne coupe jamais une partie en deux
+    if (m_used + text.size() > m_buffer.size())
+        m_buffer.resize(std::max(m_buffer.size() * 2, m_used + text.size()));
+    std::memcpy(m_buffer.data() + m_used, text.data(), text.size());
+    m_used += text.size();
+}
+
+void PgnWriter::appendToken(std::string_view token)
+{
+    if (m_column > 0 && m_column + 1 + static_cast<int>(token.size()) > PGN_LINE_LENGTH)
+    {
+        append("\n");
+        m_column = 0;
+    }
+    else if (m_column > 0)
+    {
+        append(" ");
+        ++m_column;
+    }
+    append(token);
+    m_column += static_cast<int>(token.size());
+}
+
+void PgnWriter::writeGame(const PgnTag* tags, int tagCount, const BoardState& start, const Move* moves, size_t moveCount, GameResult result)
+{
+    for (int i = 0; i < tagCount; ++i)
+    {
+        if (tags[i].name == "Result" || tags[i].name == "SetUp" || tags[i].name == "FEN")
+            continue;
+        append("[");
+        append(tags[i].name);
+        append(" \"");
+        append(tags[i].value);
+        append("\"]\n");
+    }
+    append("[Result \"");
+    append(resultToPgn(result));
+    append("\"]\n");
+
+    char fen[FEN_MAX_LENGTH];
+    const std::string_view startFen(fen, writeFen(start, fen));
+    if (startFen != START_FEN)
+    {
+        append("[SetUp \"1\"]\n[FEN \"");
+        append(startFen);
+        append("\"]\n");
+    }
+    append("\n");
+
+    // Numéro avant chaque coup blanc, et avant le premier coup s'il est noir ("12...")
+    m_board  = start;
+    m_column = 0;
+    char number[16];
+    for (size_t i = 0; i < moveCount; ++i)
+    {
+        const bool white = m_board.sideToMove() == PieceColor::White;
+        if (white || i == 0)
+        {
+            char* end = std::to_chars(number, number + sizeof(number) - 3, m_board.fullmoveNumber()).ptr;
+            for (int dots = white ? 1 : 3; dots > 0; --dots)
+                *end++ = '.';
+            appendToken(std::string_view(number, static_cast<size_t>(end - number)));
+        }
+
+        char san[SAN_MAX_LENGTH];
+        appendToken(std::string_view(san, writeSan(m_board, moves[i], san)));
+        m_board.makeMove(moves[i]);
+    }
+    appendToken(resultToPgn(result));
+    append("\n\n");
+
+    ++m_games;
+    if (m_file && m_used >= m_threshold)
+        flush();
+}
+
+bool PgnWriter::flush()
+{
+    if (!m_file)
+        return m_ok;
+    if (m_used > 0 && std::fwrite(m_buffer.data(), 1, m_used, m_file) != m_used)
+        m_ok = false;
+    m_used = 0;
+    return m_ok;
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+#include "BoardState.hpp"
+#include "Move.hpp"
+
+// Résultat d'une partie, tel qu'écrit à la fin du texte des coups
+enum class GameResult : uint8_t {
+    Unknown, // "*" : partie en cours ou abandonnée sans résultat
+    WhiteWins,
+    BlackWins,
+    Draw,
+};
+
+std::string_view resultToPgn(GameResult result);
+// Result inconnu pour tout autre texte que "1-0", "0-1", "1/2-1/2"
+GameResult resultFromPgn(std::string_view text);
+
+// --- Lecture ---
+// Les parties ne sont jamais copiées : tags et coups sont des vues dans le texte du fichier (voir MappedFile),
+// valides tant qu'il l'est.
+struct PgnTag {
+    std::string_view name;
+    std::string_view value; // sans les guillemets ; les \" éventuels sont laissés tels quels
+};
+
+struct PgnGame {
+    static constexpr int MaxTags = 32; // au-delà, les tags sont ignorés
+
+    std::array<PgnTag, MaxTags> tags{};
+    int                         tagCount = 0;
+    std::string_view            movetext; // coups, commentaires, variantes et résultat
+    std::string_view            text;     // toute la partie, tags compris
+    size_t                      offset = 0; // position de la partie dans le texte donné au lecteur
+
+    // Valeur du tag (vide s'il est absent)
+    std::string_view tag(std::string_view name) const;
+};
+
+// Découpe un texte PGN en parties : une partie commence à sa première ligne de tag et s'arrête à la première
+// ligne de tag qui suit ses coups (un '[' en début de ligne dans un commentaire ne compte pas). Aucun coup n'est lu ici.
+class PgnReader {
+public:
+    explicit PgnReader(std::string_view data) : m_data(data) {}
+
+    // false quand il n'y a plus de partie
+    bool next(PgnGame& game);
+
+private:
+    std::string_view m_data;
+    size_t           m_pos = 0;
+};
+
+// Début de la première partie qui commence à from ou après (là où PgnReader la trouverait en lisant tout le texte),
+// data.size() s'il n'y en a plus. Sert à couper un gros fichier en morceaux lisibles indépendamment.
+size_t nextGameStart(std::string_view data, size_t from);
+
+// --- Rejeu ---
+enum class PgnError {
+    None,
+    Fen,         // tag FEN illisible ou position injouable
+    IllegalMove, // coup SAN qui n'est pas légal (ou ambigu) dans la position
+    Syntax,      // commentaire ou variante jamais refermé
+};
+
+const char* pgnErrorName(PgnError error);
+
+struct ReplayedGame {
+    BoardState        start; // tag FEN, ou position initiale
+    std::vector<Move> moves; // réutilisé d'une partie à l'autre : pas d'allocation une fois la capacité atteinte
+    GameResult        result = GameResult::Unknown;
+    std::string_view  errorToken; // le coup refusé, pour les messages
+};
+
+// Rejoue les coups de la partie avec les règles (SAN lue en place, makeMove pour chaque coup) depuis le tag FEN
+// ou la position de départ. board contient ensuite la position finale (ou celle du coup refusé).
+// Commentaires, variantes, NAG et numéros de coups sont sautés ; le résultat vient du texte des coups, sinon du tag.
+PgnError replayGame(const PgnGame& game, BoardState& board, ReplayedGame& replay);
+
+// --- Écriture ---
+// Écrit des parties au format d'export PGN (lignes de 80 caractères au plus) dans un tampon, vidé dans le fichier
+// par parties entières : plusieurs writers (un par thread) peuvent partager le même fichier sans mélanger les coups.
+// Sans fichier (file nul), tout reste dans le tampon : text() le relit, clear() le vide.
+class PgnWriter {
+public:
+    explicit PgnWriter(std::FILE* file, size_t bufferSize = 1 << 20);
+    ~PgnWriter() { flush(); }
+
+    PgnWriter(const PgnWriter&)            = delete;
+    PgnWriter& operator=(const PgnWriter&) = delete;
+
+    // Les tags sont écrits dans l'ordre donné, valeurs telles quelles (déjà échappées). Result, SetUp et FEN sont
+    // ceux de la partie : ceux de la liste sont ignorés, FEN n'est écrit que si start n'est pas la position initiale.
+    void writeGame(const PgnTag* tags, int tagCount, const BoardState& start, const Move* moves, size_t moveCount, GameResult result);
+
+    // false si l'écriture dans le fichier a échoué (disque plein...)
+    bool     flush();
+    uint64_t gamesWritten() const { return m_games; }
+
+    std::string_view text() const { return {m_buffer.data(), m_used}; }
+    void             clear() { m_used = 0; }
+
+private:
+    void append(std::string_view text);
+    void appendToken(std::string_view token); // coup ou numéro, avec retour à la ligne si besoin
+
+    std::FILE*        m_file;
+    std::vector<char> m_buffer;
+    size_t            m_used      = 0;
+    size_t            m_threshold = 0; // taille à partir de laquelle on vide le tampon après une partie
+    int               m_column    = 0;
+    bool              m_ok        = true;
+    uint64_t          m_games     = 0;
+    BoardState        m_board; // position courante pendant l'écriture des coups (gardée pour réutiliser sa pile)
+};
@@ -0,0 +1,566 @@
+#include "PositionIndex.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include "Bytes.hpp"
+#include "Pgn.hpp"
+
+namespace {
+
+using namespace Bytes;
+
+constexpr size_t   HEADER_SIZE        = 48; // magic, version, réservé, parties, positions, stats, position des stats
+constexpr size_t   POSITION_SIZE      = 16;
+constexpr size_t   STATS_SIZE         = 28;
+constexpr size_t   WRITE_THRESHOLD    = 1 << 20;
+constexpr size_t   BUCKET_RECORDS     = 1024; // par thread et par partition, avant l'écriture dans le fichier temporaire
+constexpr uint64_t GAMES_PER_TASK     = 256;
+constexpr unsigned MAX_PARTITION_BITS = 8;    // 256 fichiers temporaires ouverts à la fois, au plus
+constexpr size_t   MERGE_RECORDS      = 4096; // lus d'un coup dans chaque morceau pendant une fusion
+
+// Enregistrement en mémoire et dans les fichiers temporaires (relus par la même machine : pas de conversion)
+struct Record {
+    uint64_t key;
+    uint32_t game;
+    uint16_t move; // Move::raw(), 0 pour la position finale
+    uint8_t  result;
+    uint8_t  unused;
+};
+
+bool before(const Record& a, const Record& b)
+{
+    if (a.key != b.key)
+        return a.key < b.key;
+    if (a.move != b.move)
+        return a.move < b.move;
+    return a.game < b.game;
+}
+
+struct StatsEntry {
+    uint64_t key;
+    uint16_t move;
+    uint32_t results[4];
+};
+
+bool seek(std::FILE* file, uint64_t offset)
+{
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+// Reçoit les enregistrements d'une partition dans l'ordre, les écrit à leur place dans l'index et compte les coups
+// des positions fréquentes (celles qui auront une entrée dans la table de statistiques)
+class PartitionWriter {
+public:
+    PartitionWriter(std::FILE* file, std::vector<StatsEntry>& stats) : m_file(file), m_stats(stats)
+    {
+        m_buffer.reserve(WRITE_THRESHOLD + POSITION_SIZE);
+    }
+
+    void push(const Record& record)
+    {
+        if (m_count > 0 && record.key != m_key)
+            closeGroup();
+        m_key = record.key;
+        ++m_count;
+        if (record.move != 0)
+        {
+            if (m_group.empty() || m_group.back().move != record.move)
+                m_group.push_back({record.key, record.move, {}});
+            ++m_group.back().results[record.result & 3];
+        }
+
+        uint8_t bytes[POSITION_SIZE];
+        put64(bytes, record.key);
+        put32(bytes + 8, record.game);
+        put16(bytes + 12, record.move);
+        bytes[14] = record.result;
+        bytes[15] = 0;
+        m_buffer.insert(m_buffer.end(), bytes, bytes + POSITION_SIZE);
+        if (m_buffer.size() >= WRITE_THRESHOLD)
+            flush();
+    }
+
+    bool finish()
+    {
+        if (m_count > 0)
+            closeGroup();
+        flush();
+        return m_ok;
+    }
+
+private:
+    void closeGroup()
+    {
+        if (m_count > PositionIndexFormat::STATS_THRESHOLD)
+            m_stats.insert(m_stats.end(), m_group.begin(), m_group.end());
+        m_group.clear();
+        m_count = 0;
+    }
+
+    void flush()
+    {
+        if (!m_buffer.empty() && std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size())
+            m_ok = false;
+        m_buffer.clear();
+    }
+
+    std::FILE*               m_file;
+    std::vector<StatsEntry>& m_stats;
+    std::vector<uint8_t>     m_buffer;
+    std::vector<StatsEntry>  m_group; // coups de la position en cours
+    uint64_t                 m_key   = 0;
+    uint64_t                 m_count = 0;
+    bool                     m_ok    = true;
+};
+
+// Un morceau trié d'une partition trop grosse, relu par blocs pendant la fusion
+class RunReader {
+public:
+    explicit RunReader(std::FILE* file) : m_file(file), m_buffer(MERGE_RECORDS) { std::rewind(file); }
+
+    bool next(Record& record)
+    {
+        if (m_pos == m_size)
+        {
+            m_size = std::fread(m_buffer.data(), sizeof(Record), m_buffer.size(), m_file);
+            m_pos  = 0;
+            if (m_size == 0)
+                return false;
+        }
+        record = m_buffer[m_pos++];
+        return true;
+    }
+
+private:
+    std::FILE*          m_file;
+    std::vector<Record> m_buffer;
+    size_t              m_pos  = 0;
+    size_t              m_size = 0;
+};
+
+class IndexBuilder {
+public:
+    IndexBuilder(const ArchiveReader& archive, const std::string& path, const PositionIndexOptions& options)
+        : m_archive(archive), m_path(path), m_prefix(options.tempPrefix.empty() ? path : options.tempPrefix),
+          m_threads(std::max(1u, options.threads))
+    {
+        m_budget = std::max<size_t>(options.memoryBytes / m_threads / sizeof(Record), BUCKET_RECORDS);
+    }
+
+    bool run(PositionIndexBuildStats& stats)
+    {
+        // Assez de partitions pour qu'en moyenne chacune tienne dans la mémoire d'un thread, et de quoi occuper
+        // tous les threads ; une partition plus grosse (position de départ très jouée...) passera par le disque
+        uint64_t expected = 0;
+        for (uint64_t game = 0; game < m_archive.gameCount(); ++game)
+            expected += m_archive.moveCount(game) + 1;
+        const uint64_t wanted = std::max<uint64_t>(expected / m_budget + 1, m_threads * 4);
+        unsigned       bits   = 0;
+        while (bits < MAX_PARTITION_BITS && (uint64_t(1) << bits) < wanted)
+            ++bits;
+        m_bits = bits;
+
+        const unsigned partitions = 1u << bits;
+        m_partitions.assign(partitions, nullptr);
+        m_counts.assign(partitions, 0);
+        m_stats.assign(partitions, {});
+        m_mutexes = std::make_unique<std::mutex[]>(partitions);
+        bool ok   = true;
+        for (unsigned p = 0; p < partitions && ok; ++p)
+            ok = (m_partitions[p] = std::fopen(partitionPath(p).c_str(), "w+b")) != nullptr;
+
+        if (ok)
+            ok = runThreads([this] { distribute(); });
+
+        // Chaque partition va à la suite des précédentes : les signatures sont triées d'une partition à l'autre
+        uint64_t positions = 0;
+        m_offsets.assign(partitions, 0);
+        for (unsigned p = 0; p < partitions; ++p)
+        {
+            m_offsets[p] = HEADER_SIZE + positions * POSITION_SIZE;
+            positions += m_counts[p];
+        }
+
+        if (ok)
+        {
+            std::FILE* output = std::fopen(m_path.c_str(), "wb");
+            ok                = output && std::fclose(output) == 0;
+        }
+        if (ok)
+            ok = runThreads([this] { sortPartitions(); });
+
+        for (unsigned p = 0; p < partitions; ++p)
+        {
+            if (m_partitions[p])
+                std::fclose(m_partitions[p]);
+            std::remove(partitionPath(p).c_str());
+        }
+        if (ok)
+            ok = finish(positions, stats);
+        if (!ok)
+            std::remove(m_path.c_str());
+
+        stats.positions  = positions;
+        stats.partitions = partitions;
+        stats.spilled    = m_spilled;
+        return ok;
+    }
+
+private:
+    template <typename Work>
+    bool runThreads(Work work)
+    {
+        m_next = 0;
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < m_threads; ++i)
+            workers.emplace_back(work);
+        work();
+        for (std::thread& worker : workers)
+            worker.join();
+        return !m_failed;
+    }
+
+    std::string partitionPath(unsigned partition) const { return m_prefix + ".part" + std::to_string(partition); }
+
+    unsigned partitionOf(uint64_t key) const { return m_bits == 0 ? 0 : static_cast<unsigned>(key >> (64 - m_bits)); }
+
+    // Phase 1 : rejoue les parties et répartit leurs positions dans les fichiers temporaires
+    void distribute()
+    {
+        std::vector<std::vector<Record>> buckets(m_partitions.size());
+        for (std::vector<Record>& bucket : buckets)
+            bucket.reserve(BUCKET_RECORDS);
+
+        auto add = [&](const BoardState& board, uint32_t game, uint16_t move, uint8_t result) {
+            // Une position répétée dans la partie n'y compte qu'une fois
+            if (board.isRepetition())
+                return;
+            const unsigned       partition = partitionOf(board.key());
+            std::vector<Record>& bucket    = buckets[partition];
+            bucket.push_back({board.key(), game, move, result, 0});
+            if (bucket.size() == BUCKET_RECORDS)
+                spill(partition, bucket);
+        };
+
+        BoardState   board;
+        ReplayedGame replay;
+        const uint64_t gameCount = m_archive.gameCount();
+        for (uint64_t first = m_next.fetch_add(GAMES_PER_TASK); first < gameCount && !m_failed; first = m_next.fetch_add(GAMES_PER_TASK))
+        {
+            for (uint64_t game = first; game < std::min(first + GAMES_PER_TASK, gameCount); ++game)
+            {
+                if (!m_archive.replay(game, board, replay))
+                {
+                    m_failed = true;
+                    break;
+                }
+                const auto result = static_cast<uint8_t>(replay.result);
+                board             = replay.start;
+                for (Move move : replay.moves)
+                {
+                    add(board, static_cast<uint32_t>(game), move.raw(), result);
+                    board.makeMove(move);
+                }
+                add(board, static_cast<uint32_t>(game), 0, result);
+            }
+        }
+        for (unsigned p = 0; p < buckets.size(); ++p)
+            spill(p, buckets[p]);
+    }
+
+    void spill(unsigned partition, std::vector<Record>& bucket)
+    {
+        if (bucket.empty())
+            return;
+        std::lock_guard<std::mutex> lock(m_mutexes[partition]);
+        if (std::fwrite(bucket.data(), sizeof(Record), bucket.size(), m_partitions[partition]) != bucket.size())
+            m_failed = true;
+        m_counts[partition] += bucket.size();
+        bucket.clear();
+    }
+
+    // Phase 2 : trie chaque partition et l'écrit à sa place dans l'index
+    void sortPartitions()
+    {
+        std::FILE* output = std::fopen(m_path.c_str(), "r+b");
+        if (!output)
+        {
+            m_failed = true;
+            return;
+        }
+        std::vector<Record> records;
+        for (size_t p = m_next++; p < m_partitions.size() && !m_failed; p = m_next++)
+        {
+            if (!sortPartition(static_cast<unsigned>(p), output, records))
+                m_failed = true;
+        }
+        if (std::fclose(output) != 0)
+            m_failed = true;
+    }
+
+    bool sortPartition(unsigned partition, std::FILE* output, std::vector<Record>& records)
+    {
+        std::FILE*     input = m_partitions[partition];
+        const uint64_t count = m_counts[partition];
+        if (!seek(output, m_offsets[partition]))
+            return false;
+        std::rewind(input);
+        PartitionWriter writer(output, m_stats[partition]);
+
+        if (count <= m_budget)
+        {
+            records.resize(count);
+            if (std::fread(records.data(), sizeof(Record), count, input) != count)
+                return false;
+            std::sort(records.begin(), records.end(), before);
+            for (const Record& record : records)
+                writer.push(record);
+            return writer.finish();
+        }
+
+        // Trop gros pour la mémoire : morceaux triés un par un, puis fusionnés
+        ++m_spilled;
+        std::vector<std::FILE*> runs;
+        bool                    ok = true;
+        for (uint64_t done = 0; done < count && ok; done += records.size())
+        {
+            records.resize(std::min<uint64_t>(m_budget, count - done));
+            std::FILE* run = std::fopen(runPath(partition, runs.size()).c_str(), "w+b");
+            ok             = run && std::fread(records.data(), sizeof(Record), records.size(), input) == records.size();
+            if (run)
+                runs.push_back(run);
+            if (ok)
+            {
+                std::sort(records.begin(), records.end(), before);
+                ok = std::fwrite(records.data(), sizeof(Record), records.size(), run) == records.size();
+            }
+        }
+        records.clear();
+        records.shrink_to_fit();
+
+        if (ok)
+        {
+            std::vector<RunReader> readers;
+            readers.reserve(runs.size());
+            for (std::FILE* run : runs)
+                readers.emplace_back(run);
+
+            using Head = std::pair<Record, size_t>;
+            auto later = [](const Head& a, const Head& b) { return before(b.first, a.first); };
+            std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
+            Record record;
+            for (size_t i = 0; i < readers.size(); ++i)
+            {
+                if (readers[i].next(record))
+                    heads.push({record, i});
+            }
+            while (!heads.empty())
+            {
+                const auto [smallest, run] = heads.top();
+                heads.pop();
+                writer.push(smallest);
+                if (readers[run].next(record))
+                    heads.push({record, run});
+            }
+            ok = writer.finish();
+        }
+
+        for (size_t i = 0; i < runs.size(); ++i)
+        {
+            std::fclose(runs[i]);
+            std::remove(runPath(partition, i).c_str());
+        }
+        return ok;
+    }
+
+    std::string runPath(unsigned partition, size_t run) const { return partitionPath(partition) + ".run" + std::to_string(run); }
+
+    // Table de statistiques (dans l'ordre des partitions, donc triée) et en-tête
+    bool finish(uint64_t positions, PositionIndexBuildStats& stats)
+    {
+        std::FILE* output = std::fopen(m_path.c_str(), "r+b");
+        if (!output)
+            return false;
+
+        const uint64_t       statsOffset = HEADER_SIZE + positions * POSITION_SIZE;
+        bool                 ok          = seek(output, statsOffset);
+        std::vector<uint8_t> buffer;
+        for (const std::vector<StatsEntry>& entries : m_stats)
+        {
+            for (const StatsEntry& entry : entries)
+            {
+                uint8_t bytes[STATS_SIZE] = {};
+                put64(bytes, entry.key);
+                put16(bytes + 8, entry.move);
+                for (int i = 0; i < 4; ++i)
+                    put32(bytes + 12 + 4 * i, entry.results[i]);
+                buffer.insert(buffer.end(), bytes, bytes + STATS_SIZE);
+                ++stats.stats;
+                if (buffer.size() >= WRITE_THRESHOLD)
+                {
+                    ok     = ok && std::fwrite(buffer.data(), 1, buffer.size(), output) == buffer.size();
+                    buffer.clear();
+                }
+            }
+        }
+        ok = ok && std::fwrite(buffer.data(), 1, buffer.size(), output) == buffer.size();
+
+        uint8_t header[HEADER_SIZE] = {};
+        std::memcpy(header, PositionIndexFormat::MAGIC, sizeof(PositionIndexFormat::MAGIC));
+        put32(header + 8, PositionIndexFormat::VERSION);
+        put64(header + 16, m_archive.gameCount());
+        put64(header + 24, positions);
+        put64(header + 32, stats.stats);
+        put64(header + 40, statsOffset);
+        ok = ok && seek(output, 0) && std::fwrite(header, 1, HEADER_SIZE, output) == HEADER_SIZE;
+        return std::fclose(output) == 0 && ok;
+    }
+
+    const ArchiveReader& m_archive;
+    std::string          m_path;
+    std::string          m_prefix;
+    unsigned             m_threads;
+    size_t               m_budget; // enregistrements triés en mémoire par un thread
+    unsigned             m_bits = 0;
+
+    std::vector<std::FILE*>              m_partitions;
+    std::vector<uint64_t>                m_counts;
+    std::vector<uint64_t>                m_offsets;
+    std::vector<std::vector<StatsEntry>> m_stats; // une liste par partition, remplie par le thread qui la trie
+    std::unique_ptr<std::mutex[]>        m_mutexes;
+    std::atomic<uint64_t>                m_next{0};
+    std::atomic<bool>                    m_failed{false};
+    std::atomic<unsigned>                m_spilled{0};
+};
+
+} // namespace
+
+bool buildPositionIndex(const ArchiveReader& archive, const std::string& path, const PositionIndexOptions& options, PositionIndexBuildStats* stats)
+{
+    PositionIndexBuildStats local;
+    IndexBuilder            builder(archive, path, options);
+    const bool              ok = builder.run(local);
+    if (stats)
+        *stats = local;
+    return ok;
+}
+
+// --- Requêtes ---
+
+bool PositionIndex::open(const std::string& path)
+{
+    m_positions     = nullptr;
+    m_positionCount = 0;
+    m_statsCount    = 0;
+    if (!m_file.open(path) || m_file.size() < HEADER_SIZE)
+        return false;
+
+    const auto*    base = reinterpret_cast<const uint8_t*>(m_file.view().data());
+    const uint64_t size = m_file.size();
+    if (std::memcmp(base, PositionIndexFormat::MAGIC, sizeof(PositionIndexFormat::MAGIC)) != 0
+        || get32(base + 8) != PositionIndexFormat::VERSION)
+        return false;
+
+    const uint64_t positions   = get64(base + 24);
+    const uint64_t stats       = get64(base + 32);
+    const uint64_t statsOffset = get64(base + 40);
+    if (positions > (size - HEADER_SIZE) / POSITION_SIZE || statsOffset != HEADER_SIZE + positions * POSITION_SIZE
+        || stats > (size - statsOffset) / STATS_SIZE)
+        return false;
+
+    m_gameCount     = get64(base + 16);
+    m_positionCount = positions;
+    m_statsCount    = stats;
+    m_positions     = base + HEADER_SIZE;
+    m_stats         = base + statsOffset;
+    return true;
+}
+
+void PositionIndex::range(uint64_t key, uint64_t& first, uint64_t& last) const
+{
+    uint64_t low = 0, high = m_positionCount;
+    while (low < high)
+    {
+        const uint64_t middle = low + (high - low) / 2;
+        if (get64(m_positions + middle * POSITION_SIZE) < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    first = low;
+
+    high = m_positionCount;
+    while (low < high)
+    {
+        const uint64_t middle = low + (high - low) / 2;
+        if (get64(m_positions + middle * POSITION_SIZE) <= key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    last = low;
+}
+
+uint64_t PositionIndex::games(uint64_t key, uint32_t* out, size_t maxGames) const
+{
+    uint64_t first = 0, last = 0;
+    range(key, first, last);
+    for (uint64_t i = first; i < last && i - first < maxGames; ++i)
+        out[i - first] = get32(m_positions + i * POSITION_SIZE + 8);
+    return last - first;
+}
+
+void PositionIndex::moves(uint64_t key, std::vector<MoveStats>& out) const
+{
+    out.clear();
+    uint64_t first = 0, last = 0;
+    range(key, first, last);
+
+    if (last - first > PositionIndexFormat::STATS_THRESHOLD)
+    {
+        // Position fréquente : ses coups sont déjà comptés dans la table de statistiques
+        uint64_t low = 0, high = m_statsCount;
+        while (low < high)
+        {
+            const uint64_t middle = low + (high - low) / 2;
+            if (get64(m_stats + middle * STATS_SIZE) < key)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        for (const uint8_t* entry = m_stats + low * STATS_SIZE; low < m_statsCount && get64(entry) == key; ++low, entry += STATS_SIZE)
+        {
+            MoveStats stats;
+            stats.move = Move::fromRaw(get16(entry + 8));
+            for (int i = 0; i < 4; ++i)
+                stats.results[i] = get32(entry + 12 + 4 * i);
+            out.push_back(stats);
+        }
+    }
+    else
+    {
+        // Triés par coup : chaque coup forme une suite d'enregistrements
+        for (const uint8_t* record = m_positions + first * POSITION_SIZE; first < last; ++first, record += POSITION_SIZE)
+        {
+            const uint16_t move = get16(record + 12);
+            if (move == 0)
+                continue;
+            if (out.empty() || out.back().move.raw() != move)
+                out.push_back({Move::fromRaw(move)});
+            ++out.back().results[record[14] & 3];
+        }
+    }
+
+    std::sort(out.begin(), out.end(), [](const MoveStats& a, const MoveStats& b) {
+        return a.games() != b.games() ? a.games() > b.games() : a.move.raw() < b.move.raw();
+    });
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Archive.hpp"
+#include "MappedFile.hpp"
+#include "Move.hpp"
+
+/*
+ * Index des positions d'une archive de parties : pour chaque position rencontrée, les parties qui y sont passées
+ * et les coups qui y ont été joués, avec leurs résultats.
+ *
+ *   en-tête    "CHESSPOS", version, nombre de parties de l'archive, d'enregistrements, de statistiques
+ *   positions  16 octets : signature, numéro de partie, coup joué (0 : la partie finit là), résultat
+ *              triés par (signature, coup, partie) ; une position n'y est qu'une fois par partie
+ *   stats      28 octets : signature, coup, puis le nombre de parties par résultat (dans l'ordre de GameResult)
+ *              seulement pour les positions vues plus de STATS_THRESHOLD fois : les autres se comptent en lisant
+ *              directement leurs quelques enregistrements
+ *
+ * Les deux tables sont triées : une requête est une recherche dichotomique dans le fichier projeté en mémoire.
+ */
+namespace PositionIndexFormat {
+
+inline constexpr char     MAGIC[8]        = {'C', 'H', 'E', 'S', 'S', 'P', 'O', 'S'};
+inline constexpr uint32_t VERSION         = 1;
+inline constexpr uint64_t STATS_THRESHOLD = 32;
+
+} // namespace PositionIndexFormat
+
+struct MoveStats {
+    Move     move;
+    uint32_t results[4] = {}; // indexé par GameResult
+
+    uint32_t games() const { return results[0] + results[1] + results[2] + results[3]; }
+};
+
+class PositionIndex {
+public:
+    // false si le fichier n'existe pas ou n'est pas un index complet
+    bool open(const std::string& path);
+
+    uint64_t gameCount() const { return m_gameCount; } // parties de l'archive indexée
+    uint64_t positionCount() const { return m_positionCount; }
+
+    // Nombre de parties passées par la position ; les numéros des maxGames premières (dans l'ordre de l'index,
+    // regroupées par coup joué) sont écrits dans out
+    uint64_t games(uint64_t key, uint32_t* out, size_t maxGames) const;
+
+    // Coups joués dans la position, du plus joué au moins joué ; les parties qui s'y arrêtent n'y sont pas
+    void moves(uint64_t key, std::vector<MoveStats>& out) const;
+
+private:
+    // [first, last) : enregistrements de la position
+    void range(uint64_t key, uint64_t& first, uint64_t& last) const;
+
+    MappedFile     m_file;
+    const uint8_t* m_positions     = nullptr;
+    const uint8_t* m_stats         = nullptr;
+    uint64_t       m_gameCount     = 0;
+    uint64_t       m_positionCount = 0;
+    uint64_t       m_statsCount    = 0;
+};
+
+struct PositionIndexOptions {
+    unsigned    threads     = 1;
+    size_t      memoryBytes = size_t(1) << 30; // pour tous les threads : au-delà, le tri passe par le disque
+    std::string tempPrefix;                    // fichiers temporaires ; vide : à côté de l'index
+};
+
+struct PositionIndexBuildStats {
+    uint64_t positions  = 0;
+    uint64_t stats      = 0;
+    unsigned partitions = 0;
+    unsigned spilled    = 0; // partitions trop grosses pour la mémoire, triées par morceaux puis fusionnées
+};
+
+// Rejoue toutes les parties de l'archive et écrit l'index. Tri externe partitionné : les enregistrements sont
+// répartis par les bits hauts de la signature dans des fichiers temporaires, puis chaque partition est triée
+// (en mémoire, ou par morceaux fusionnés si elle dépasse sa part de memoryBytes) et écrite à sa place.
+// false si une partie est illisible ou si une écriture échoue.
+bool buildPositionIndex(const ArchiveReader& archive, const std::string& path, const PositionIndexOptions& options,
+                        PositionIndexBuildStats* stats = nullptr);
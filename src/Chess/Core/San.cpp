@@ -0,0 +1,182 @@
+#include "San.hpp"
+#include "MoveGen.hpp"
+
+namespace {
+
+PieceType pieceFromLetter(char c)
+{
+    switch (c)
+    {
+    case 'N': return PieceType::Knight;
+    case 'B': return PieceType::Bishop;
+    case 'R': return PieceType::Rook;
+    case 'Q': return PieceType::Queen;
+    case 'K': return PieceType::King;
+    default: return PieceType::None;
+    }
+}
+
+char letterFromPiece(PieceType type)
+{
+    switch (type)
+    {
+    case PieceType::Knight: return 'N';
+    case PieceType::Bishop: return 'B';
+    case PieceType::Rook: return 'R';
+    case PieceType::Queen: return 'Q';
+    case PieceType::King: return 'K';
+    default: return 'P';
+    }
+}
+
+} // namespace
+
+Move parseSan(const BoardState& board, std::string_view san)
+{
+    while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' || san.back() == '?'))
+        san.remove_suffix(1);
+    if (san.size() < 2)
+        return Move::none();
+
+    const PieceColor us = board.sideToMove();
+    MoveList         moves;
+
+    // Roques (on tolère les zéros, fréquents dans les fichiers PGN)
+    if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0")
+    {
+        const int flag = san.size() == 3 ? KingCastle : QueenCastle;
+        generateLegalMoves(board, moves, board.pieces(us, PieceType::King));
+        for (Move move : moves)
+        {
+            if (move.flags() == flag)
+                return move;
+        }
+        return Move::none();
+    }
+
+    // Pièce, puis éventuelle promotion à la fin, et la case d'arrivée juste avant
+    PieceType piece = pieceFromLetter(san.front());
+    if (piece == PieceType::None)
+        piece = PieceType::Pawn;
+    else
+        san.remove_prefix(1);
+
+    PieceType promotion = PieceType::None;
+    if (piece == PieceType::Pawn && !san.empty() && pieceFromLetter(san.back()) != PieceType::None)
+    {
+        promotion = pieceFromLetter(san.back());
+        san.remove_suffix(1);
+        if (!san.empty() && san.back() == '=')
+            san.remove_suffix(1);
+    }
+    if (san.size() < 2)
+        return Move::none();
+
+    const char toFile = san[san.size() - 2];
+    const char toRank = san[san.size() - 1];
+    if (toFile < 'a' || toFile > 'h' || toRank < '1' || toRank > '8')
+        return Move::none();
+    const int to = makeSquare(toFile - 'a', toRank - '1');
+    san.remove_suffix(2);
+
+    // Ce qui reste : précision de colonne et/ou de rangée, et le 'x' de la prise
+    int fromFile = -1, fromRank = -1;
+    for (char c : san)
+    {
+        if (c >= 'a' && c <= 'h')
+            fromFile = c - 'a';
+        else if (c >= '1' && c <= '8')
+            fromRank = c - '1';
+        else if (c != 'x' && c != ':' && c != '-')
+            return Move::none();
+    }
+
+    // Seules les pièces du bon type, sur la bonne colonne / rangée, sont générées
+    Bitboard fromMask = board.pieces(us, piece);
+    if (fromFile >= 0)
+        fromMask &= FILE_A_BB << fromFile;
+    if (fromRank >= 0)
+        fromMask &= RANK_1_BB << (8 * fromRank);
+    generateLegalMoves(board, moves, fromMask);
+
+    Move found = Move::none();
+    for (Move move : moves)
+    {
+        if (move.to() != to || move.isCastling())
+            continue;
+        if (move.isPromotion() ? move.promotionType() != promotion : promotion != PieceType::None)
+            continue;
+        if (found)
+            return Move::none(); // ambigu
+        found = move;
+    }
+    return found;
+}
+
+size_t writeSan(BoardState& board, Move move, char* out)
+{
+    char* end = out;
+    if (move.isCastling())
+    {
+        for (char c : std::string_view(move.flags() == KingCastle ? "O-O" : "O-O-O"))
+            *end++ = c;
+    }
+    else
+    {
+        const PieceType piece   = board.typeAt(move.from());
+        const bool      capture = !board.isEmpty(move.to()) || move.isEnPassant();
+        const int       from    = move.from();
+        if (piece == PieceType::Pawn)
+        {
+            if (capture)
+                *end++ = static_cast<char>('a' + fileOf(from));
+        }
+        else
+        {
+            *end++ = letterFromPiece(piece);
+
+            // Les autres pièces du même type qui peuvent aller sur la case : on précise la colonne si elle suffit,
+            // sinon la rangée, sinon les deux
+            MoveList others;
+            generateLegalMoves(board, others, board.pieces(board.sideToMove(), piece) & ~squareBB(from));
+            bool ambiguous = false, sameFile = false, sameRank = false;
+            for (Move other : others)
+            {
+                if (other.to() != move.to())
+                    continue;
+                ambiguous = true;
+                sameFile |= fileOf(other.from()) == fileOf(from);
+                sameRank |= rankOf(other.from()) == rankOf(from);
+            }
+            if (ambiguous && (!sameFile || sameRank))
+                *end++ = static_cast<char>('a' + fileOf(from));
+            if (ambiguous && sameFile)
+                *end++ = static_cast<char>('1' + rankOf(from));
+        }
+        if (capture)
+            *end++ = 'x';
+        *end++ = static_cast<char>('a' + fileOf(move.to()));
+        *end++ = static_cast<char>('1' + rankOf(move.to()));
+        if (move.isPromotion())
+        {
+            *end++ = '=';
+            *end++ = letterFromPiece(move.promotionType());
+        }
+    }
+
+    board.makeMove(move);
+    if (board.inCheck())
+    {
+        MoveList replies;
+        generateLegalMoves(board, replies);
+        *end++ = replies.empty() ? '#' : '+';
+    }
+    board.unmakeMove();
+    return static_cast<size_t>(end - out);
+}
+
+std::string toSan(BoardState& board, Move move)
+{
+    char buffer[SAN_MAX_LENGTH];
+    return std::string(buffer, writeSan(board, move, buffer));
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "BoardState.hpp"
+#include "Move.hpp"
+
+// Notation algébrique standard (SAN) : Nf3, exd5, O-O, e8=Q+, Rad1...
+// Les suffixes d'échec et d'annotation (+, #, !, ?) sont acceptés et ignorés ; la promotion peut s'écrire e8=Q ou e8Q.
+// Renvoie Move::none() si le texte ne désigne pas exactement un coup légal de la position.
+Move parseSan(const BoardState& board, std::string_view san);
+
+// Au plus 7 caractères : "exd8=Q+", "Qa1xb2#"
+constexpr size_t SAN_MAX_LENGTH = 8;
+
+// Écrit le coup en SAN dans out (au moins SAN_MAX_LENGTH octets, sans zéro final) et renvoie sa longueur :
+// colonne et/ou rangée de départ seulement si une autre pièce du même type peut aller sur la case, =Q pour une
+// promotion, + ou # s'il donne échec ou mat. Le coup est joué puis défait pour le savoir : board revient tel quel.
+size_t      writeSan(BoardState& board, Move move, char* out);
+std::string toSan(BoardState& board, Move move);
@@ -0,0 +1,27 @@
+#include "Zobrist.hpp"
+#include "BoardState.hpp"
+
+namespace Zobrist {
+
+uint64_t computeKey(const BoardState& board)
+{
+    uint64_t key = 0;
+    for (PieceColor color : {PieceColor::White, PieceColor::Black})
+    {
+        for (int type = 0; type < 6; ++type)
+        {
+            Bitboard pieces = board.pieces(color, static_cast<PieceType>(type + 1));
+            while (pieces)
+                key ^= PieceKeys[colorIndex(color)][type][popLsb(pieces)];
+        }
+    }
+
+    key ^= CastlingKeys[board.castlingRights()];
+    if (board.enPassantSquare() != NO_SQUARE)
+        key ^= EnPassantKeys[fileOf(board.enPassantSquare())];
+    if (board.sideToMove() == PieceColor::Black)
+        key ^= SideKey;
+    return key;
+}
+
+} // namespace Zobrist
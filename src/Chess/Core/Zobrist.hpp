@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Bitboard.hpp"
+
+class BoardState;
+
+// Clés aléatoires de Zobrist : la signature d'une position est le XOR des clés de ce qu'elle contient
+namespace Zobrist {
+
+namespace detail {
+
+// splitmix64 avec une graine fixe : les clés sont identiques d'une exécution à l'autre
+// (indispensable pour les fichiers indexés par signature)
+constexpr uint64_t nextKey(uint64_t& state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+struct Keys {
+    std::array<std::array<std::array<uint64_t, 64>, 6>, 2> pieces{};
+    std::array<uint64_t, 16>                               castling{};
+    std::array<uint64_t, 8>                                enPassant{};
+    uint64_t                                               side = 0;
+};
+
+// Calculées à la compilation (comme les tables de Psqt) : d'autres tables constantes peuvent en dépendre
+// sans souci d'ordre d'initialisation
+constexpr Keys buildKeys()
+{
+    Keys     keys;
+    uint64_t state = 0x43686573734B6579ULL;
+    for (auto& color : keys.pieces)
+        for (auto& type : color)
+            for (uint64_t& key : type)
+                key = nextKey(state);
+
+    // Un droit de roque = une clé, une combinaison de droits = le XOR des clés correspondantes
+    std::array<uint64_t, 4> rightKeys{};
+    for (uint64_t& key : rightKeys)
+        key = nextKey(state);
+    for (int rights = 0; rights < 16; ++rights)
+    {
+        for (int bit = 0; bit < 4; ++bit)
+        {
+            if (rights & (1 << bit))
+                keys.castling[rights] ^= rightKeys[bit];
+        }
+    }
+
+    for (uint64_t& key : keys.enPassant)
+        key = nextKey(state);
+    keys.side = nextKey(state);
+    return keys;
+}
+
+inline constexpr Keys KEYS = buildKeys();
+
+} // namespace detail
+
+inline constexpr const auto& PieceKeys     = detail::KEYS.pieces;    // [couleur][type][case]
+inline constexpr const auto& CastlingKeys  = detail::KEYS.castling;
+inline constexpr const auto& EnPassantKeys = detail::KEYS.enPassant; // par colonne
+inline constexpr uint64_t    SideKey       = detail::KEYS.side;      // trait aux noirs
+
+inline uint64_t piece(PieceColor color, PieceType type, int sq) { return PieceKeys[colorIndex(color)][typeIndex(type)][sq]; }
+
+// Signature recalculée à partir de zéro
+uint64_t computeKey(const BoardState& board);
+
+} // namespace Zobrist
@@ -22,7 +22,7 @@ std::string DrunkChessMode::getModeDescription() const {
     return "Mode où les joueurs consomment de l'alcool virtuel, affectant leur précision et visibilité";
 }
 
-void DrunkChessMode::initializeBoard(std::vector<Piece>& board)
+void DrunkChessMode::initializeBoard(BoardState& board)
 {
     GameMode::initializeBoard(board);
 
@@ -34,7 +34,7 @@ void DrunkChessMode::initializeBoard(std::vector<Piece>& board)
     m_bottles.clear();
 }
 
-bool DrunkChessMode::isValidMove(const std::vector<Piece>& board, Position from, Position to, const Piece& piece) {
+bool DrunkChessMode::isValidMove(const BoardState& board, Position from, Position to, const Piece& piece) {
     PlayerState& currentPlayerState = (piece.color == PieceColor::White) ? 
                                     m_whitePlayerState : m_blackPlayerState;
     
@@ -46,8 +46,10 @@ bool DrunkChessMode::isValidMove(const std::vector<Piece>& board, Position from,
     return GameMode::isValidMove(board, from, to, piece);
 }
 
-void DrunkChessMode::executeMove(std::vector<Piece>& board, Position from, Position to) {
-    Piece piece = board[from.x + from.y * 8];
+void DrunkChessMode::executeMove(BoardState& board, Move move) {
+    Position from  = positionOf(move.from());
+    Position to    = positionOf(move.to());
+    Piece    piece = board.get(from);
     PlayerState& currentPlayerState = (piece.color == PieceColor::White) ? 
                                     m_whitePlayerState : m_blackPlayerState;
     
@@ -73,7 +75,7 @@ void DrunkChessMode::executeMove(std::vector<Piece>& board, Position from, Posit
             
             if (deviatedPos.isValid()) {
                 // Vérifier si la case déviée ne contient pas une pièce alliée
-                Piece targetPiece = board[deviatedPos.x + deviatedPos.y * 8];
+                Piece targetPiece = board.get(deviatedPos);
                 if (targetPiece.type == PieceType::None || targetPiece.color != piece.color) {
                     actualTo = deviatedPos;
                 }
@@ -81,7 +83,7 @@ void DrunkChessMode::executeMove(std::vector<Piece>& board, Position from, Posit
         }
     }
     
-    Piece capturedPiece = board[actualTo.x + actualTo.y * 8];
+    Piece capturedPiece = board.get(actualTo);
     bool needsPromotion = isPawnPromotion(actualTo, piece);
     
     bool capturedBottle = hasBottleAt(actualTo);
@@ -97,7 +99,16 @@ void DrunkChessMode::executeMove(std::vector<Piece>& board, Position from, Posit
         removeBottleAt(actualTo);
     }
     
-    GameMode::executeMove(board, from, actualTo);
+    // Coup dévié : ce n'est plus le coup légal prévu, juste un déplacement (avec promotion en dame si besoin)
+    if (!(actualTo == to)) {
+        int flags = (capturedPiece.type != PieceType::None) ? Capture : Quiet;
+        if (needsPromotion) {
+            flags |= promotionFlag(PieceType::Queen);
+        }
+        move = Move(move.from(), squareOf(actualTo), flags);
+    }
+
+    GameMode::executeMove(board, move);
     
     // Augmenter l'alcoolémie après un mouvement
     float alcoholIncrease = std::uniform_real_distribution<float>(1.0f, 5.0f)(m_random);
@@ -142,7 +153,7 @@ bool DrunkChessMode::isPawnPromotion(Position to, Piece piece) const {
     return false;
 }
 
-void DrunkChessMode::updatePerTurn(std::vector<Piece>& board, PieceColor currentTurn) {
+void DrunkChessMode::updatePerTurn(BoardState& board, PieceColor currentTurn) {
     m_turnCount++;
     
     // Mise à jour des niveaux d'alcool et des états de blackout
@@ -156,7 +167,7 @@ void DrunkChessMode::updatePerTurn(std::vector<Piece>& board, PieceColor current
     trySpawnBottle(board);
 }
 
-void DrunkChessMode::trySpawnBottle(const std::vector<Piece>& board) {
+void DrunkChessMode::trySpawnBottle(const BoardState& board) {
     //std::cout << "Tentative de création d'une bouteille..." << std::endl;
     //la loi de Bernoulli
     if (m_bottleSpawnDist(m_random)) {
@@ -166,7 +177,7 @@ void DrunkChessMode::trySpawnBottle(const std::vector<Piece>& board) {
         for (int y = 0; y < 8; ++y) {
             for (int x = 0; x < 8; ++x) {
                 Position pos = {x, y};
-                if (board[pos.x + pos.y * 8].type == PieceType::None && !hasBottleAt(pos)) {
+                if (board.get(pos).type == PieceType::None && !hasBottleAt(pos)) {
                     emptyPositions.push_back(pos);
                 }
             }
@@ -29,10 +29,10 @@ public:
     std::string getModeDescription() const override;
 
     // Redéfinition uniquement des méthodes qui changent dans le mode bourré
-    void initializeBoard(std::vector<Piece>& board) override;
-    bool isValidMove(const std::vector<Piece>& board, Position from, Position to, const Piece& piece) override;
-    void executeMove(std::vector<Piece>& board, Position from, Position to) override;
-    void updatePerTurn(std::vector<Piece>& board, PieceColor currentTurn) override;
+    void initializeBoard(BoardState& board) override;
+    bool isValidMove(const BoardState& board, Position from, Position to, const Piece& piece) override;
+    void executeMove(BoardState& board, Move move) override;
+    void updatePerTurn(BoardState& board, PieceColor currentTurn) override;
 
     ImVec4 getTileColor(bool isPairLine, int index, Position pos) const override;
     void   drawTileEffect(Position pos, ImVec2 cursorPos, Piece piece) const override;
@@ -53,7 +53,7 @@ private:
     float  getPlayerAlcoholLevel(PieceColor color) const;
     float  getAverageAlcoholLevel() const;
     bool   isPawnPromotion(Position to, Piece piece) const;
-    void   trySpawnBottle(const std::vector<Piece>& board);
+    void   trySpawnBottle(const BoardState& board);
     bool   hasBottleAt(Position pos) const;
     void   removeBottleAt(Position pos);
 
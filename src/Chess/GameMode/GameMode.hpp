@@ -1,6 +1,8 @@
 #pragma once
 #include "../Position.hpp"
 #include "../Piece.hpp"
+#include "../Core/BoardState.hpp"
+#include "../Core/Move.hpp"
 #include <vector>
 #include <string>
 #include <imgui.h>
@@ -13,15 +15,12 @@ public:
     virtual std::string getModeName() const { return "Mode de base"; }
     virtual std::string getModeDescription() const { return "Implémentation par défaut"; }
     
-    virtual void initializeBoard(std::vector<Piece>& board);
-    virtual bool isValidMove(const std::vector<Piece>& board, Position from, Position to, const Piece& piece);
-    virtual void executeMove(std::vector<Piece>& board, Position from, Position to);
-    virtual void updatePerTurn(std::vector<Piece>& board, PieceColor currentTurn) {}
+    virtual void initializeBoard(BoardState& board);
+    virtual bool isValidMove(const BoardState& board, Position from, Position to, const Piece& piece);
+    virtual void executeMove(BoardState& board, Move move);
+    virtual void updatePerTurn(BoardState& board, PieceColor currentTurn) {}
     
     virtual void drawModeSpecificUI() {}
     virtual ImVec4 getTileColor(bool isPairLine, int index, Position pos) const;
     virtual void drawTileEffect(Position pos, ImVec2 cursorPos, Piece piece) const {}
-
-private:
-    bool isPathClear(const std::vector<Piece>& board, Position from, Position to) const;
 };
\ No newline at end of file
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool de threads avec vol de tâches.
+ *
+ * Chaque thread a sa propre file : les tâches sont distribuées à tour de rôle, un thread dépile
+ * les siennes par la fin et, quand il n'a plus rien, vole les plus anciennes des autres (par le début).
+ * Les tâches très inégales (sous-arbres de perft, parties d'un fichier PGN...) s'équilibrent ainsi toutes seules.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(unsigned threadCount = std::thread::hardware_concurrency())
+    {
+        threadCount = threadCount ? threadCount : 1;
+        for (unsigned i = 0; i < threadCount; ++i)
+            m_queues.push_back(std::make_unique<Queue>());
+        for (unsigned i = 0; i < threadCount; ++i)
+            m_threads.emplace_back([this, i] { run(i); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wakeUp.notify_all();
+        for (std::thread& thread : m_threads)
+            thread.join();
+    }
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(m_threads.size()); }
+
+    void submit(Task task)
+    {
+        Queue& queue = *m_queues[m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_queued;
+            ++m_pending;
+        }
+        m_wakeUp.notify_one();
+    }
+
+    // Bloque jusqu'à ce que toutes les tâches soumises soient terminées
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_pending == 0; });
+    }
+
+private:
+    struct Queue {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool tryPop(unsigned index, Task& task)
+    {
+        // D'abord sa propre file, par la fin (tâche la plus récente, données encore en cache)
+        {
+            Queue&                      own = *m_queues[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        // Sinon on vole la plus ancienne tâche d'un autre thread
+        for (size_t offset = 1; offset < m_queues.size(); ++offset)
+        {
+            Queue&                      victim = *m_queues[(index + offset) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(unsigned index)
+    {
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeUp.wait(lock, [this] { return m_stop || m_queued > 0; });
+                if (m_queued == 0)
+                    return; // arrêt demandé et plus rien en file
+                --m_queued; // on "réserve" une tâche : il y en a forcément une dans l'une des files
+            }
+
+            Task task;
+            while (!tryPop(index, task))
+            {
+                // la tâche réservée a été poussée dans une file qu'on vient de dépasser : on refait un tour
+            }
+
+            task();
+
+            bool finished = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                finished = (--m_pending == 0);
+            }
+            if (finished)
+                m_idle.notify_all();
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread>            m_threads;
+    std::atomic<size_t>                 m_next{0};
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_idle;
+    size_t                  m_queued  = 0; // tâches en file, pas encore prises
+    size_t                  m_pending = 0; // tâches soumises et pas encore terminées
+    bool                    m_stop    = false;
+};
@@ -0,0 +1,317 @@
+// Archives de parties (voir Archive.hpp) : un octet par coup, lecture par projection en mémoire.
+//
+//   archive pack <entrée.pgn> <sortie.arc>     rejoue chaque partie PGN et l'ajoute à l'archive
+//   archive unpack <entrée.arc> <sortie.pgn>   réécrit toutes les parties en PGN
+//   archive show <entrée.arc> <n>              affiche la partie n (à partir de 0) en PGN
+//   archive bench <entrée.arc> [--games N]     rejoue N parties tirées au hasard et donne le temps par partie
+//   archive index <entrée.arc> <sortie.idx> [--threads T] [--memory Mo]
+//                                             index des positions (voir PositionIndex.hpp)
+//   archive explore <entrée.arc> <entrée.idx> [FEN]
+//                                             coups joués dans la position et parties qui y sont passées
+//
+// pack garde l'ordre du fichier : un seul thread, la table de chaînes de l'archive n'est pas partagée.
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include "Chess/Core/Archive.hpp"
+#include "Chess/Core/Fen.hpp"
+#include "Chess/Core/MappedFile.hpp"
+#include "Chess/Core/Pgn.hpp"
+#include "Chess/Core/PositionIndex.hpp"
+#include "Chess/Core/San.hpp"
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Entier positif de la ligne de commande : false si text n'est pas un nombre en entier (signe, lettres, débordement)
+bool parseArgument(const char* text, uint64_t& value)
+{
+    const char* const end    = text + std::strlen(text);
+    const auto [next, error] = std::from_chars(text, end, value);
+    return error == std::errc() && next == end;
+}
+
+int pack(const std::string& input, const std::string& output)
+{
+    MappedFile file;
+    if (!file.open(input))
+    {
+        std::fprintf(stderr, "cannot open %s\n", input.c_str());
+        return 1;
+    }
+    file.adviseSequential();
+
+    ArchiveWriter writer;
+    if (!writer.open(output))
+    {
+        std::fprintf(stderr, "cannot create %s\n", output.c_str());
+        return 1;
+    }
+
+    const auto   start = std::chrono::steady_clock::now();
+    PgnReader    reader(file.view());
+    PgnGame      game;
+    BoardState   board;
+    ReplayedGame replay;
+    uint64_t     games = 0, moves = 0, rejected = 0;
+    while (reader.next(game))
+    {
+        ++games;
+        const PgnError error = replayGame(game, board, replay);
+        if (error != PgnError::None
+            || !writer.addGame(game.tags.data(), game.tagCount, replay.start, replay.moves.data(), replay.moves.size(), replay.result))
+        {
+            ++rejected;
+            continue;
+        }
+        moves += replay.moves.size();
+    }
+    if (!writer.close())
+    {
+        std::fprintf(stderr, "cannot write %s\n", output.c_str());
+        return 1;
+    }
+    const double seconds = secondsSince(start);
+
+    ArchiveReader archive;
+    if (!archive.open(output))
+    {
+        std::fprintf(stderr, "cannot read back %s\n", output.c_str());
+        return 1;
+    }
+    std::printf("games    : %llu (%llu rejected)\n", static_cast<unsigned long long>(games), static_cast<unsigned long long>(rejected));
+    std::printf("moves    : %llu\n", static_cast<unsigned long long>(moves));
+    std::printf("size     : %zu -> %zu bytes (%.1fx smaller, %.2f bytes/move)\n", file.size(), archive.fileSize(),
+                archive.fileSize() ? static_cast<double>(file.size()) / archive.fileSize() : 0.0,
+                moves ? static_cast<double>(archive.fileSize()) / moves : 0.0);
+    std::printf("time     : %.3f s, %.2f M moves/s\n", seconds, seconds > 0 ? moves / seconds / 1e6 : 0.0);
+    return rejected == 0 ? 0 : 1;
+}
+
+int unpack(const ArchiveReader& archive, uint64_t first, uint64_t last, std::FILE* output)
+{
+    PgnWriter    writer(output);
+    BoardState   board;
+    ReplayedGame replay;
+    PgnTag       tags[PgnGame::MaxTags];
+    int          status = 0;
+    for (uint64_t i = first; i < last; ++i)
+    {
+        if (!archive.replay(i, board, replay))
+        {
+            std::fprintf(stderr, "game %llu: corrupted archive\n", static_cast<unsigned long long>(i));
+            status = 1;
+            continue;
+        }
+        const int tagCount = archive.tags(i, tags, PgnGame::MaxTags);
+        writer.writeGame(tags, tagCount, replay.start, replay.moves.data(), replay.moves.size(), replay.result);
+    }
+    if (!writer.flush())
+        status = 1;
+    return status;
+}
+
+int bench(const ArchiveReader& archive, uint64_t games)
+{
+    if (archive.gameCount() == 0)
+    {
+        std::fprintf(stderr, "empty archive\n");
+        return 1;
+    }
+
+    // Accès au hasard : c'est l'index qui doit faire le travail, pas la lecture séquentielle
+    std::mt19937_64 rng(1);
+    BoardState      board;
+    ReplayedGame    replay;
+    uint64_t        moves = 0;
+    const auto      start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < games; ++i)
+    {
+        if (!archive.replay(rng() % archive.gameCount(), board, replay))
+        {
+            std::fprintf(stderr, "corrupted archive\n");
+            return 1;
+        }
+        moves += replay.moves.size();
+    }
+    const double seconds = secondsSince(start);
+    std::printf("games    : %llu replayed out of %llu\n", static_cast<unsigned long long>(games), static_cast<unsigned long long>(archive.gameCount()));
+    std::printf("replay   : %.2f us/game, %.2f M moves/s\n", seconds * 1e6 / games, seconds > 0 ? moves / seconds / 1e6 : 0.0);
+    return 0;
+}
+
+int buildIndex(const ArchiveReader& archive, const std::string& output, int argc, char** argv, const char* usage)
+{
+    PositionIndexOptions options;
+    options.threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < argc; ++i)
+    {
+        const std::string arg   = argv[i];
+        uint64_t          value = 0;
+        if ((arg == "--threads" || arg == "--memory") && i + 1 < argc && !parseArgument(argv[i + 1], value))
+        {
+            std::fprintf(stderr, "invalid value for %s: %s\n%s", arg.c_str(), argv[i + 1], usage);
+            return 1;
+        }
+
+        if (arg == "--threads" && i + 1 < argc)
+            options.threads = static_cast<unsigned>(std::clamp<uint64_t>(value, 1, UINT32_MAX));
+        else if (arg == "--memory" && i + 1 < argc)
+            options.memoryBytes = static_cast<size_t>(std::clamp<uint64_t>(value, 1, SIZE_MAX >> 20)) << 20;
+        else
+        {
+            std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+        ++i;
+    }
+
+    PositionIndexBuildStats stats;
+    const auto              start = std::chrono::steady_clock::now();
+    if (!buildPositionIndex(archive, output, options, &stats))
+    {
+        std::fprintf(stderr, "cannot build %s (corrupted archive or write error)\n", output.c_str());
+        return 1;
+    }
+    const double seconds = secondsSince(start);
+    std::printf("positions: %llu (%llu move statistics)\n", static_cast<unsigned long long>(stats.positions),
+                static_cast<unsigned long long>(stats.stats));
+    std::printf("sort     : %u partition(s), %u sorted on disk, %u thread(s), %zu MB\n", stats.partitions, stats.spilled,
+                options.threads, options.memoryBytes >> 20);
+    std::printf("time     : %.3f s, %.2f M positions/s\n", seconds, seconds > 0 ? stats.positions / seconds / 1e6 : 0.0);
+    return 0;
+}
+
+int explore(const ArchiveReader& archive, const std::string& indexPath, const char* fen)
+{
+    PositionIndex index;
+    if (!index.open(indexPath))
+    {
+        std::fprintf(stderr, "cannot open %s (missing, truncated or not an index)\n", indexPath.c_str());
+        return 1;
+    }
+    if (index.gameCount() != archive.gameCount())
+    {
+        std::fprintf(stderr, "%s was not built from this archive\n", indexPath.c_str());
+        return 1;
+    }
+    BoardState board;
+    if (parseFen(board, fen ? fen : START_FEN) != FenError::None)
+    {
+        std::fprintf(stderr, "invalid FEN\n");
+        return 1;
+    }
+
+    constexpr size_t       MAX_GAMES = 10;
+    uint32_t               games[MAX_GAMES];
+    std::vector<MoveStats> moves;
+    const auto             start     = std::chrono::steady_clock::now();
+    const uint64_t         gameCount = index.games(board.key(), games, MAX_GAMES);
+    index.moves(board.key(), moves);
+    const double seconds = secondsSince(start);
+
+    std::printf("%llu game(s), query %.1f us\n", static_cast<unsigned long long>(gameCount), seconds * 1e6);
+    for (const MoveStats& stats : moves)
+    {
+        const double total = stats.games();
+        std::printf("  %-8s %8u  +%5.1f%% =%5.1f%% -%5.1f%%\n", toSan(board, stats.move).c_str(), stats.games(),
+                    100 * stats.results[static_cast<int>(GameResult::WhiteWins)] / total,
+                    100 * stats.results[static_cast<int>(GameResult::Draw)] / total,
+                    100 * stats.results[static_cast<int>(GameResult::BlackWins)] / total);
+    }
+    for (uint64_t i = 0; i < std::min<uint64_t>(gameCount, MAX_GAMES); ++i)
+    {
+        const std::string_view white = archive.tag(games[i], "White"), black = archive.tag(games[i], "Black");
+        const std::string_view result = resultToPgn(archive.result(games[i]));
+        std::printf("  #%-8u %.*s - %.*s %.*s\n", games[i], static_cast<int>(white.size()), white.data(),
+                    static_cast<int>(black.size()), black.data(), static_cast<int>(result.size()), result.data());
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* usage = "usage: archive pack <in.pgn> <out.arc>\n"
+                        "       archive unpack <in.arc> <out.pgn>\n"
+                        "       archive show <in.arc> <game>\n"
+                        "       archive bench <in.arc> [--games N]\n"
+                        "       archive index <in.arc> <out.idx> [--threads T] [--memory MB]\n"
+                        "       archive explore <in.arc> <in.idx> [FEN]\n";
+    if (argc < 3)
+    {
+        std::fprintf(stderr, "%s", usage);
+        return 1;
+    }
+
+    const std::string command = argv[1];
+    if (command == "pack" && argc == 4)
+        return pack(argv[2], argv[3]);
+
+    ArchiveReader archive;
+    if ((command == "unpack" || command == "show" || command == "bench" || command == "index" || command == "explore")
+        && !archive.open(argv[2]))
+    {
+        std::fprintf(stderr, "cannot open %s (missing, truncated or not an archive)\n", argv[2]);
+        return 1;
+    }
+
+    if (command == "unpack" && argc == 4)
+    {
+        std::FILE* output = std::fopen(argv[3], "wb");
+        if (!output)
+        {
+            std::fprintf(stderr, "cannot create %s\n", argv[3]);
+            return 1;
+        }
+        const int status = unpack(archive, 0, archive.gameCount(), output);
+        return std::fclose(output) == 0 ? status : 1;
+    }
+    if (command == "show" && argc == 4)
+    {
+        uint64_t game = 0;
+        if (!parseArgument(argv[3], game))
+        {
+            std::fprintf(stderr, "%s", usage);
+            return 1;
+        }
+        if (game >= archive.gameCount())
+        {
+            std::fprintf(stderr, "no game %llu (%llu in archive)\n", static_cast<unsigned long long>(game),
+                         static_cast<unsigned long long>(archive.gameCount()));
+            return 1;
+        }
+        return unpack(archive, game, game + 1, stdout);
+    }
+    if (command == "bench")
+    {
+        uint64_t games = 100000;
+        if (argc == 5 && std::string(argv[3]) == "--games" && parseArgument(argv[4], games))
+            games = std::max<uint64_t>(1, games);
+        else if (argc != 3)
+        {
+            std::fprintf(stderr, "%s", usage);
+            return 1;
+        }
+        return bench(archive, games);
+    }
+
+    if (command == "index" && argc >= 4)
+        return buildIndex(archive, argv[3], argc - 4, argv + 4, usage);
+    if (command == "explore" && (argc == 4 || argc == 5))
+        return explore(archive, argv[3], argc == 5 ? argv[4] : nullptr);
+
+    std::fprintf(stderr, "%s", usage);
+    return 1;
+}
@@ -0,0 +1,180 @@
+// Banc d'essai de la recherche : profondeur atteinte sur un jeu de positions fixe, à budget de noeuds fixe.
+//
+//   bench [--nodes N] [--depth D] [--threads T] [--hash MB] [--fen "<fen>"] [--nnue <fichier>] [--kernel scalar|sse41|avx2]
+//         [--movetime MS] [--time MS --inc MS [--movestogo N]]
+//         [--no-nmp] [--no-lmr] [--no-rfp] [--no-futility] [--no-razoring] [--no-check-ext] [--no-singular]
+//
+// Avec un contrôle du temps (et sans --nodes), c'est le gestionnaire de temps qui décide quand s'arrêter :
+// la colonne time montre ce qu'il dépense réellement.
+// Chaque position part d'une table vide. On coupe une technique avec --no-... et on compare la profondeur
+// moyenne atteinte : c'est ce qu'elle apporte au temps-pour-profondeur.
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Chess/AI/Endgames.hpp"
+#include "Chess/AI/Nnue.hpp"
+#include "Chess/AI/Search.hpp"
+#include "Chess/AI/TranspositionTable.hpp"
+#include "Chess/Core/Fen.hpp"
+
+namespace {
+
+// Ouvertures, milieux de partie tactiques et finales (dont du zugzwang)
+const std::vector<std::string> BENCH_POSITIONS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+    "r2q1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP2BPPP/R2Q1RK1 w - - 0 9",
+    "2r3k1/pp3ppp/3b4/3p4/3P1B2/2P5/PP3PPP/4R1K1 w - - 0 25",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "8/8/p1p5/1p5p/1P5p/8/PPP2K1p/4R1rk w - - 0 1",
+    "8/k7/3p4/p2P1p2/P2P1P2/8/8/K7 w - - 0 1",
+};
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Nombre de la ligne de commande : false si text n'est pas un nombre en entier (lettres, débordement...)
+template <typename T>
+bool parseArgument(const char* text, T& value)
+{
+    const char* const end    = text + std::strlen(text);
+    const auto [next, error] = std::from_chars(text, end, value);
+    return error == std::errc() && next == end;
+}
+
+bool parseToggle(const std::string& arg, SearchParams& params)
+{
+    if (arg == "--no-nmp")
+        params.nullMove = false;
+    else if (arg == "--no-lmr")
+        params.lateMoveReduction = false;
+    else if (arg == "--no-rfp")
+        params.reverseFutility = false;
+    else if (arg == "--no-futility")
+        params.futility = false;
+    else if (arg == "--no-razoring")
+        params.razoring = false;
+    else if (arg == "--no-check-ext")
+        params.checkExtension = false;
+    else if (arg == "--no-singular")
+        params.singularExtension = false;
+    else
+        return false;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    SearchLimits             limits;
+    size_t                   hashMegabytes = 16;
+    std::vector<std::string> positions     = BENCH_POSITIONS;
+    Nnue::Network            network;
+    std::string              networkPath;
+    bool                     nodesGiven = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--nodes" && i + 1 < argc && parseArgument(argv[++i], limits.nodes))
+            nodesGiven = true;
+        else if (arg == "--movetime" && i + 1 < argc && parseArgument(argv[++i], limits.movetimeMs))
+            continue;
+        else if (arg == "--time" && i + 1 < argc && parseArgument(argv[++i], limits.timeMs[0]))
+            limits.timeMs[1] = limits.timeMs[0];
+        else if (arg == "--inc" && i + 1 < argc && parseArgument(argv[++i], limits.incrementMs[0]))
+            limits.incrementMs[1] = limits.incrementMs[0];
+        else if (arg == "--movestogo" && i + 1 < argc && parseArgument(argv[++i], limits.movesToGo))
+            continue;
+        else if (arg == "--depth" && i + 1 < argc && parseArgument(argv[++i], limits.depth))
+            continue;
+        else if (arg == "--threads" && i + 1 < argc && parseArgument(argv[++i], limits.threads))
+            continue;
+        else if (arg == "--hash" && i + 1 < argc && parseArgument(argv[++i], hashMegabytes))
+            continue;
+        else if (arg == "--fen" && i + 1 < argc)
+            positions = {argv[++i]};
+        else if (arg == "--nnue" && i + 1 < argc)
+            networkPath = argv[++i];
+        else if (arg == "--kernel" && i + 1 < argc)
+        {
+            const std::string kernel = argv[++i];
+            network.setKernel(kernel == "scalar" ? Nnue::Kernel::Scalar : kernel == "sse41" ? Nnue::Kernel::Sse41 : Nnue::Kernel::Avx2);
+        }
+        else if (!parseToggle(arg, limits.params))
+        {
+            std::fprintf(stderr, "usage: bench [--nodes N] [--depth D] [--threads T] [--hash MB] [--fen \"<fen>\"] [--nnue <file>] [--kernel scalar|sse41|avx2]\n"
+                                 "             [--movetime MS] [--time MS --inc MS [--movestogo N]]\n"
+                                 "             [--no-nmp] [--no-lmr] [--no-rfp] [--no-futility] [--no-razoring] [--no-check-ext] [--no-singular]\n");
+            return 1;
+        }
+    }
+
+    // Budget de noeuds par défaut, sauf si c'est le temps qui limite
+    if (!nodesGiven && limits.movetimeMs == 0 && limits.timeMs[0] == 0)
+        limits.nodes = 1000000;
+
+    if (!networkPath.empty())
+    {
+        if (!network.load(networkPath))
+        {
+            std::fprintf(stderr, "invalid network: %s\n", networkPath.c_str());
+            return 1;
+        }
+        limits.network = &network;
+        std::printf("network %s (%s)\n\n", networkPath.c_str(), Nnue::kernelName(network.kernel()));
+    }
+
+    Endgames::init();
+    TranspositionTable tt(hashMegabytes);
+    std::atomic<bool>  stop{false};
+    uint64_t           totalNodes     = 0;
+    int                totalDepth     = 0;
+    uint64_t           pawnProbes     = 0;
+    uint64_t           pawnHits       = 0;
+    uint64_t           materialProbes = 0;
+    uint64_t           materialHits   = 0;
+    auto               start          = std::chrono::steady_clock::now();
+
+    for (const std::string& fen : positions)
+    {
+        BoardState board;
+        if (!loadFen(board, fen))
+        {
+            std::fprintf(stderr, "invalid FEN: %s\n", fen.c_str());
+            return 1;
+        }
+
+        tt.clear();
+        const SearchInfo info = searchParallel(board, limits, tt, stop);
+        totalNodes += info.nodes;
+        totalDepth += info.depth;
+        pawnProbes += info.pawnProbes;
+        pawnHits += info.pawnHits;
+        materialProbes += info.materialProbes;
+        materialHits += info.materialHits;
+        std::printf("depth %2d  seldepth %2d  score %6d  nodes %10llu  time %6lld ms  %-6s %s\n", info.depth, info.selDepth, info.score,
+                    static_cast<unsigned long long>(info.nodes), static_cast<long long>(info.timeMs), moveToUci(info.bestMove).c_str(),
+                    fen.c_str());
+    }
+
+    const double seconds = secondsSince(start);
+    std::printf("\naverage depth : %.2f\n", static_cast<double>(totalDepth) / positions.size());
+    std::printf("nodes         : %llu\n", static_cast<unsigned long long>(totalNodes));
+    std::printf("time          : %.3f s\n", seconds);
+    std::printf("nps           : %.0f\n", seconds > 0 ? totalNodes / seconds : 0.0);
+    std::printf("pawn hash     : %.1f%% hits\n", pawnProbes ? 100.0 * pawnHits / pawnProbes : 0.0);
+    std::printf("material hash : %.1f%% hits\n", materialProbes ? 100.0 * materialHits / materialProbes : 0.0);
+    return 0;
+}
@@ -0,0 +1,187 @@
+// Suites de test EPD : cherche chaque position et compare le coup trouvé aux opérations bm (meilleur coup) / am (coup à éviter).
+//
+//   epd <fichier> [--movetime MS] [--depth D] [--threads T] [--hash MB]
+//   epd <fichier> --parse [--repeat N]      vitesse de lecture seule (ns par position), et aller-retour lecture / écriture
+//
+// Les lignes invalides sont signalées avec la raison du refus, puis ignorées.
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Chess/AI/Endgames.hpp"
+#include "Chess/AI/Search.hpp"
+#include "Chess/AI/TranspositionTable.hpp"
+#include "Chess/Core/Fen.hpp"
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Nombre de la ligne de commande : false si text n'est pas un nombre en entier (lettres, débordement...)
+template <typename T>
+bool parseArgument(const char* text, T& value)
+{
+    const char* const end    = text + std::strlen(text);
+    const auto [next, error] = std::from_chars(text, end, value);
+    return error == std::errc() && next == end;
+}
+
+// Mêmes opérations, dans le même ordre
+bool sameOperations(const EpdRecord& a, const EpdRecord& b)
+{
+    if (a.count != b.count)
+        return false;
+    for (int i = 0; i < a.count; ++i)
+    {
+        if (a.operations[i].opcode != b.operations[i].opcode || a.operations[i].operands != b.operations[i].operands)
+            return false;
+    }
+    return true;
+}
+
+// Lecture seule, répétée : le coût d'une position, la vérification que writeEpd relit bien ce qu'on a lu, et que
+// le découpage rapide des opérations donne la même chose que celui de référence (parseEpdScalar)
+int parseBench(const std::vector<std::string>& lines, int repeat)
+{
+    BoardState board, scalarBoard;
+    EpdRecord  record, scalarRecord;
+    size_t     valid = 0, mismatches = 0, operationMismatches = 0;
+    for (const std::string& line : lines)
+    {
+        const FenError error = parseEpd(board, line, record);
+        if (parseEpdScalar(scalarBoard, line, scalarRecord) != error || (error == FenError::None && !sameOperations(record, scalarRecord)))
+            ++operationMismatches;
+        if (error != FenError::None)
+            continue;
+        ++valid;
+
+        char       written[FEN_MAX_LENGTH];
+        const auto length = writeEpd(board, written);
+        BoardState reread;
+        EpdRecord  empty;
+        if (parseEpd(reread, std::string_view(written, length), empty) != FenError::None || reread.key() != board.key())
+            ++mismatches;
+    }
+
+    const auto start    = std::chrono::steady_clock::now();
+    uint64_t   checksum = 0;
+    for (int r = 0; r < repeat; ++r)
+    {
+        for (const std::string& line : lines)
+        {
+            if (parseEpd(board, line, record) == FenError::None)
+                checksum += board.key();
+        }
+    }
+    const double seconds = secondsSince(start);
+    const double parsed  = static_cast<double>(lines.size()) * repeat;
+
+    std::printf("positions     : %zu valid / %zu\n", valid, lines.size());
+    std::printf("round trip    : %zu mismatch(es)\n", mismatches);
+    std::printf("operations    : %zu mismatch(es) against the scalar parser\n", operationMismatches);
+    std::printf("parse         : %.1f ns per position (checksum %016llx)\n", seconds * 1e9 / parsed, static_cast<unsigned long long>(checksum));
+    return mismatches == 0 && operationMismatches == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* usage = "usage: epd <file> [--movetime MS] [--depth D] [--threads T] [--hash MB]\n"
+                        "       epd <file> --parse [--repeat N]\n";
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "%s", usage);
+        return 1;
+    }
+
+    SearchLimits limits;
+    limits.movetimeMs    = 1000;
+    size_t hashMegabytes = 64;
+    bool   parseOnly     = false;
+    int    repeat        = 100;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--movetime" && i + 1 < argc && parseArgument(argv[++i], limits.movetimeMs))
+            continue;
+        else if (arg == "--depth" && i + 1 < argc && parseArgument(argv[++i], limits.depth))
+            limits.movetimeMs = 0;
+        else if (arg == "--threads" && i + 1 < argc && parseArgument(argv[++i], limits.threads))
+            continue;
+        else if (arg == "--hash" && i + 1 < argc && parseArgument(argv[++i], hashMegabytes))
+            continue;
+        else if (arg == "--parse")
+            parseOnly = true;
+        else if (arg == "--repeat" && i + 1 < argc && parseArgument(argv[++i], repeat))
+            repeat = std::max(1, repeat);
+        else
+        {
+            std::fprintf(stderr, "unknown option or invalid value: %s\n%s", arg.c_str(), usage);
+            return 1;
+        }
+    }
+
+    std::ifstream            file(argv[1]);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line);)
+    {
+        if (!line.empty() && line[0] != '#')
+            lines.push_back(line);
+    }
+    if (!file.eof() && lines.empty())
+    {
+        std::fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    if (parseOnly)
+        return parseBench(lines, repeat);
+
+    Endgames::init();
+    TranspositionTable tt(hashMegabytes);
+    std::atomic<bool>  stop{false};
+    int                solved = 0, total = 0;
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        BoardState board;
+        EpdRecord  record;
+        if (const FenError error = parseEpd(board, lines[i], record); error != FenError::None)
+        {
+            std::printf("line %zu: %s\n", i + 1, fenErrorName(error));
+            continue;
+        }
+
+        MoveList best, avoid;
+        if (record.has("bm") && !epdMoves(board, record.operands("bm"), best))
+        {
+            std::printf("line %zu: illegal bm move\n", i + 1);
+            continue;
+        }
+        if (record.has("am") && !epdMoves(board, record.operands("am"), avoid))
+        {
+            std::printf("line %zu: illegal am move\n", i + 1);
+            continue;
+        }
+
+        tt.clear();
+        const SearchInfo info = searchParallel(board, limits, tt, stop);
+        const bool       ok   = (best.empty() || best.contains(info.bestMove)) && !avoid.contains(info.bestMove);
+        solved += ok;
+        ++total;
+
+        const std::string_view id = record.id();
+        std::printf("%-20.*s %-6s depth %2d  score %6d  %s\n", static_cast<int>(id.size()), id.data(), moveToUci(info.bestMove).c_str(),
+                    info.depth, info.score, ok ? "ok" : "FAIL");
+    }
+    std::printf("\nsolved %d / %d\n", solved, total);
+    return 0;
+}
@@ -0,0 +1,166 @@
+// Banc d'essai du générateur de coups : compte les noeuds de l'arbre et mesure la vitesse.
+//
+//   perft [--fen "<fen>"] [--depth N] [--divide] [--threads T] [--hash MB]
+//   perft --suite [--depth N] [--threads T] [--hash MB]   positions de référence, profondeur max N (5 par défaut)
+//
+// Avec --threads ou --hash, les sous-arbres sont répartis sur un pool de threads (perftParallel),
+// éventuellement avec une table partagée des comptes de sous-arbres.
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Chess/Core/Fen.hpp"
+#include "Chess/Core/Perft.hpp"
+
+namespace {
+
+struct ReferencePosition {
+    const char*           fen;
+    std::vector<uint64_t> nodes; // nodes[d - 1] = perft(d)
+};
+
+// Positions de référence classiques (chessprogramming.org/Perft_Results)
+const std::vector<ReferencePosition> REFERENCE_SUITE = {
+    {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", {20, 400, 8902, 197281, 4865609, 119060324}},
+    {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", {48, 2039, 97862, 4085603, 193690690}},
+    {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", {14, 191, 2812, 43238, 674624, 11030083, 178633661}},
+    {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", {6, 264, 9467, 422333, 15833292}},
+    {"r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1", {6, 264, 9467, 422333, 15833292}},
+    {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", {44, 1486, 62379, 2103487, 89941194}},
+    {"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", {46, 2079, 89890, 3894594, 164075551}},
+};
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Nombre de la ligne de commande : false si text n'est pas un nombre en entier (lettres, débordement...)
+template <typename T>
+bool parseArgument(const char* text, T& value)
+{
+    const char* const end    = text + std::strlen(text);
+    const auto [next, error] = std::from_chars(text, end, value);
+    return error == std::errc() && next == end;
+}
+
+// Le chemin séquentiel reste celui de référence : le parallèle n'est utilisé que s'il est demandé
+uint64_t countNodes(const BoardState& board, int depth, const PerftOptions& options, std::vector<PerftDivideEntry>* divide)
+{
+    if (options.threads > 1 || options.hashMegabytes > 0)
+        return perftParallel(board, depth, options, divide);
+
+    if (divide)
+    {
+        *divide = perftDivide(board, depth);
+        uint64_t total = 0;
+        for (const PerftDivideEntry& entry : *divide)
+            total += entry.nodes;
+        return total;
+    }
+    return perft(board, depth);
+}
+
+void printSpeed(uint64_t nodes, double seconds)
+{
+    std::printf("time  : %.3f s\n", seconds);
+    std::printf("nps   : %.0f\n", seconds > 0 ? nodes / seconds : 0.0);
+}
+
+int runSingle(const std::string& fen, int depth, bool divide, const PerftOptions& options)
+{
+    BoardState board;
+    if (!loadFen(board, fen))
+    {
+        std::fprintf(stderr, "invalid FEN: %s\n", fen.c_str());
+        return 1;
+    }
+
+    std::vector<PerftDivideEntry> entries;
+    auto                          start   = std::chrono::steady_clock::now();
+    uint64_t                      total   = countNodes(board, depth, options, divide ? &entries : nullptr);
+    double                        seconds = secondsSince(start);
+
+    if (divide)
+    {
+        for (const PerftDivideEntry& entry : entries)
+            std::printf("%s: %llu\n", moveToUci(entry.move).c_str(), static_cast<unsigned long long>(entry.nodes));
+        std::printf("\n");
+    }
+
+    std::printf("nodes : %llu\n", static_cast<unsigned long long>(total));
+    printSpeed(total, seconds);
+    return 0;
+}
+
+int runSuite(int maxDepth, const PerftOptions& options)
+{
+    int      failures   = 0;
+    uint64_t totalNodes = 0;
+    auto     start      = std::chrono::steady_clock::now();
+
+    for (const ReferencePosition& reference : REFERENCE_SUITE)
+    {
+        BoardState board;
+        loadFen(board, reference.fen);
+        std::printf("%s\n", reference.fen);
+
+        for (int depth = 1; depth <= maxDepth && depth <= static_cast<int>(reference.nodes.size()); ++depth)
+        {
+            uint64_t nodes    = countNodes(board, depth, options, nullptr);
+            uint64_t expected = reference.nodes[depth - 1];
+            totalNodes += nodes;
+            std::printf("  depth %d : %12llu  %s\n", depth, static_cast<unsigned long long>(nodes), nodes == expected ? "ok" : "FAILED");
+            if (nodes != expected)
+            {
+                std::printf("             expected %llu\n", static_cast<unsigned long long>(expected));
+                ++failures;
+            }
+        }
+    }
+
+    std::printf("\n%s (%d failure(s))\n", failures ? "SUITE FAILED" : "suite passed", failures);
+    printSpeed(totalNodes, secondsSince(start));
+    return failures ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string  fen(START_FEN);
+    int          depth  = -1;
+    bool         divide = false;
+    bool         suite  = false;
+    PerftOptions options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--fen" && i + 1 < argc)
+            fen = argv[++i];
+        else if (arg == "--depth" && i + 1 < argc && parseArgument(argv[++i], depth))
+            continue;
+        else if (arg == "--divide")
+            divide = true;
+        else if (arg == "--suite")
+            suite = true;
+        else if (arg == "--threads" && i + 1 < argc && parseArgument(argv[++i], options.threads))
+            continue;
+        else if (arg == "--hash" && i + 1 < argc && parseArgument(argv[++i], options.hashMegabytes))
+            continue;
+        else
+        {
+            std::fprintf(stderr, "usage: perft [--fen \"<fen>\"] [--depth N] [--divide] [--threads T] [--hash MB]\n"
+                                 "       perft --suite [--depth N] [--threads T] [--hash MB]\n");
+            return 1;
+        }
+    }
+
+    if (suite)
+        return runSuite(depth > 0 ? depth : 5, options);
+    return runSingle(fen, depth > 0 ? depth : 5, divide, options);
+}
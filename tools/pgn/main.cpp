@@ -0,0 +1,379 @@
+// Import de collections PGN : le fichier est projeté en mémoire, découpé en morceaux alignés sur les parties,
+// et chaque partie est rejouée coup par coup avec les règles pour la valider.
+//
+//   pgn <fichier.pgn> [--threads T] [--errors N] [--export <sortie.pgn>]
+//   pgn --selfplay N --export <sortie.pgn> [--nodes K] [--random P] [--threads T]
+//
+// Chaque thread prend le morceau suivant dès qu'il a fini le sien : aucune partie n'est copiée, aucune
+// allocation par coup. Les N premières parties refusées sont affichées (position dans le fichier et raison).
+// Avec --export, les parties valides sont réécrites au format d'export (SAN recalculée, sans commentaires) ;
+// chaque morceau est réécrit en mémoire puis les morceaux vont dans le fichier dans leur ordre : la sortie est
+// la même quel que soit le nombre de threads.
+// --selfplay fait jouer N parties au moteur contre lui-même (K noeuds par coup, P premiers demi-coups au hasard
+// pour varier les ouvertures) et les écrit en PGN.
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Chess/AI/Endgames.hpp"
+#include "Chess/AI/Search.hpp"
+#include "Chess/AI/TranspositionTable.hpp"
+#include "Chess/Core/Fen.hpp"
+#include "Chess/Core/MappedFile.hpp"
+#include "Chess/Core/MoveGen.hpp"
+#include "Chess/Core/Pgn.hpp"
+
+namespace {
+
+// Assez gros pour que le découpage ne coûte rien, assez petit pour équilibrer la charge entre les threads
+constexpr size_t CHUNK_SIZE = 4 << 20;
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Nombre de la ligne de commande : false si text n'est pas un nombre en entier (lettres, débordement...)
+template <typename T>
+bool parseArgument(const char* text, T& value)
+{
+    const char* const end    = text + std::strlen(text);
+    const auto [next, error] = std::from_chars(text, end, value);
+    return error == std::errc() && next == end;
+}
+
+struct ImportStats {
+    uint64_t games    = 0;
+    uint64_t moves    = 0;
+    uint64_t rejected = 0;
+    uint64_t results[4] = {}; // indexé par GameResult
+
+    void add(const ImportStats& other)
+    {
+        games += other.games;
+        moves += other.moves;
+        rejected += other.rejected;
+        for (int i = 0; i < 4; ++i)
+            results[i] += other.results[i];
+    }
+};
+
+class Importer {
+public:
+    Importer(std::string_view data, int maxErrors, std::FILE* output) : m_data(data), m_output(output), m_maxErrors(maxErrors)
+    {
+        // Les frontières sont calées sur des débuts de partie : chaque morceau se lit sans rien savoir des autres
+        m_bounds.push_back(0);
+        for (size_t pos = CHUNK_SIZE; pos < data.size(); pos += CHUNK_SIZE)
+        {
+            const size_t start = nextGameStart(data, pos);
+            if (start > m_bounds.back() && start < data.size())
+                m_bounds.push_back(start);
+        }
+        m_bounds.push_back(data.size());
+        if (m_output)
+        {
+            m_pending.resize(m_bounds.size() - 1);
+            m_done.resize(m_bounds.size() - 1);
+        }
+    }
+
+    ImportStats run(unsigned threads)
+    {
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads; ++i)
+            workers.emplace_back([this] { work(); });
+        work();
+        for (std::thread& worker : workers)
+            worker.join();
+        return m_total;
+    }
+
+private:
+    void work()
+    {
+        BoardState   board;
+        ReplayedGame replay;
+        PgnGame      game;
+        ImportStats  stats;
+        PgnWriter    writer(nullptr); // le texte d'un morceau, écrit par emit() à son tour
+        for (size_t chunk = m_nextChunk++; chunk + 1 < m_bounds.size(); chunk = m_nextChunk++)
+        {
+            const size_t begin = m_bounds[chunk];
+            PgnReader    reader(m_data.substr(begin, m_bounds[chunk + 1] - begin));
+            while (reader.next(game))
+            {
+                ++stats.games;
+                const PgnError error = replayGame(game, board, replay);
+                stats.moves += replay.moves.size();
+                if (error != PgnError::None)
+                {
+                    ++stats.rejected;
+                    report(begin + game.offset, error, replay.errorToken);
+                    continue;
+                }
+                ++stats.results[static_cast<int>(replay.result)];
+                if (m_output)
+                    writer.writeGame(game.tags.data(), game.tagCount, replay.start, replay.moves.data(), replay.moves.size(), replay.result);
+            }
+            if (m_output)
+            {
+                emit(chunk, writer.text());
+                writer.clear();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_total.add(stats);
+    }
+
+    // Écrit le texte du morceau s'il est le suivant dans le fichier (et ceux qui attendaient derrière lui),
+    // sinon le garde de côté jusqu'à ce que les morceaux précédents soient écrits
+    void emit(size_t chunk, std::string_view text)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (chunk != m_written)
+        {
+            m_pending[chunk].assign(text);
+            m_done[chunk] = true;
+            return;
+        }
+
+        std::fwrite(text.data(), 1, text.size(), m_output);
+        for (++m_written; m_written < m_done.size() && m_done[m_written]; ++m_written)
+        {
+            std::fwrite(m_pending[m_written].data(), 1, m_pending[m_written].size(), m_output);
+            std::string().swap(m_pending[m_written]);
+        }
+    }
+
+    void report(size_t offset, PgnError error, std::string_view token)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_reported >= m_maxErrors)
+            return;
+        ++m_reported;
+        std::printf("offset %zu: %s", offset, pgnErrorName(error));
+        if (!token.empty())
+            std::printf(" (%.*s)", static_cast<int>(token.size()), token.data());
+        std::printf("\n");
+    }
+
+    std::string_view    m_data;
+    std::FILE*          m_output; // nul : validation seule
+    std::vector<size_t> m_bounds;
+    std::atomic<size_t> m_nextChunk{0};
+
+    // Export : textes des morceaux terminés avant leur tour (protégés par m_mutex)
+    std::vector<std::string> m_pending;
+    std::vector<bool>        m_done;
+    size_t                   m_written = 0; // morceaux déjà dans le fichier
+
+    std::mutex  m_mutex;
+    ImportStats m_total;
+    int         m_maxErrors;
+    int         m_reported = 0;
+};
+
+// Plus aucun mat possible : rois seuls, ou un seul fou / cavalier en tout
+bool insufficientMaterial(const BoardState& board)
+{
+    if (board.pieces(PieceType::Pawn) | board.pieces(PieceType::Rook) | board.pieces(PieceType::Queen))
+        return false;
+    const Bitboard minors = board.pieces(PieceType::Knight) | board.pieces(PieceType::Bishop);
+    return !moreThanOne(minors);
+}
+
+class SelfPlay {
+public:
+    SelfPlay(uint64_t games, uint64_t nodes, int randomPlies, std::FILE* output)
+        : m_games(games), m_nodes(nodes), m_randomPlies(randomPlies), m_output(output)
+    {
+    }
+
+    ImportStats run(unsigned threads)
+    {
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads; ++i)
+            workers.emplace_back([this] { work(); });
+        work();
+        for (std::thread& worker : workers)
+            worker.join();
+        return m_total;
+    }
+
+private:
+    static constexpr size_t MAX_GAME_PLIES = 400; // au-delà, nulle d'office
+
+    void work()
+    {
+        TranspositionTable tt(4);
+        Search             search(tt);
+        std::atomic<bool>  stop{false};
+        SearchLimits       limits;
+        limits.nodes = m_nodes;
+
+        BoardState start;
+        loadFen(start, START_FEN);
+        BoardState        board;
+        std::vector<Move> moves;
+        PgnWriter         writer(m_output);
+        ImportStats       stats;
+        for (uint64_t game = m_nextGame++; game < m_games; game = m_nextGame++)
+        {
+            // Une graine par partie : les premiers coups ne dépendent pas du thread qui la joue
+            std::mt19937_64 rng(game);
+            board = start;
+            moves.clear();
+            GameResult result = GameResult::Draw;
+            while (true)
+            {
+                MoveList legal;
+                generateLegalMoves(board, legal);
+                if (legal.empty())
+                {
+                    if (board.inCheck())
+                        result = board.sideToMove() == PieceColor::White ? GameResult::BlackWins : GameResult::WhiteWins;
+                    break;
+                }
+                if (board.halfmoveClock() >= 100 || board.isRepetition() || insufficientMaterial(board) || moves.size() >= MAX_GAME_PLIES)
+                    break;
+
+                const Move move = static_cast<int>(moves.size()) < m_randomPlies ? legal[rng() % legal.size()] : search.run(board, limits, stop).bestMove;
+                board.makeMove(move);
+                moves.push_back(move);
+            }
+
+            char       round[24];
+            const auto roundLength = static_cast<size_t>(std::to_chars(round, round + sizeof(round), game + 1).ptr - round);
+            const PgnTag tags[] = {{"Event", "Self-play"}, {"Site", "?"}, {"Date", "????.??.??"}, {"Round", std::string_view(round, roundLength)},
+                                   {"White", "chess_core"}, {"Black", "chess_core"}};
+            writer.writeGame(tags, static_cast<int>(std::size(tags)), start, moves.data(), moves.size(), result);
+
+            ++stats.games;
+            stats.moves += moves.size();
+            ++stats.results[static_cast<int>(result)];
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_total.add(stats);
+    }
+
+    uint64_t              m_games;
+    uint64_t              m_nodes;
+    int                   m_randomPlies;
+    std::FILE*            m_output;
+    std::atomic<uint64_t> m_nextGame{0};
+
+    std::mutex  m_mutex;
+    ImportStats m_total;
+};
+
+void printStats(const ImportStats& stats, double seconds, unsigned threads, size_t bytes)
+{
+    std::printf("games    : %llu (%llu rejected)\n", static_cast<unsigned long long>(stats.games), static_cast<unsigned long long>(stats.rejected));
+    std::printf("results  : +%llu =%llu -%llu *%llu\n", static_cast<unsigned long long>(stats.results[static_cast<int>(GameResult::WhiteWins)]),
+                static_cast<unsigned long long>(stats.results[static_cast<int>(GameResult::Draw)]),
+                static_cast<unsigned long long>(stats.results[static_cast<int>(GameResult::BlackWins)]),
+                static_cast<unsigned long long>(stats.results[static_cast<int>(GameResult::Unknown)]));
+    std::printf("moves    : %llu\n", static_cast<unsigned long long>(stats.moves));
+    std::printf("time     : %.3f s, %u thread(s)\n", seconds, threads);
+    std::printf("speed    : %.2f M moves/s, %.1f MB/s\n", seconds > 0 ? stats.moves / seconds / 1e6 : 0.0,
+                seconds > 0 ? static_cast<double>(bytes) / seconds / 1e6 : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* usage = "usage: pgn <file.pgn> [--threads T] [--errors N] [--export <out.pgn>]\n"
+                        "       pgn --selfplay N --export <out.pgn> [--nodes K] [--random P] [--threads T]\n";
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "%s", usage);
+        return 1;
+    }
+
+    unsigned    threads   = std::max(1u, std::thread::hardware_concurrency());
+    int         maxErrors = 10;
+    std::string input, exportPath;
+    uint64_t    selfPlayGames = 0, nodes = 500;
+    int         randomPlies   = 8;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc && parseArgument(argv[++i], threads))
+            threads = std::max(1u, threads);
+        else if (arg == "--errors" && i + 1 < argc && parseArgument(argv[++i], maxErrors))
+            maxErrors = std::max(0, maxErrors);
+        else if (arg == "--export" && i + 1 < argc)
+            exportPath = argv[++i];
+        else if (arg == "--selfplay" && i + 1 < argc && parseArgument(argv[++i], selfPlayGames))
+            continue;
+        else if (arg == "--nodes" && i + 1 < argc && parseArgument(argv[++i], nodes))
+            nodes = std::max<uint64_t>(1, nodes);
+        else if (arg == "--random" && i + 1 < argc && parseArgument(argv[++i], randomPlies))
+            randomPlies = std::max(0, randomPlies);
+        else if (input.empty() && arg[0] != '-')
+            input = arg;
+        else
+        {
+            std::fprintf(stderr, "unknown option or invalid value: %s\n%s", arg.c_str(), usage);
+            return 1;
+        }
+    }
+    if (input.empty() == (selfPlayGames == 0) || (selfPlayGames > 0 && exportPath.empty()))
+    {
+        std::fprintf(stderr, "%s", usage);
+        return 1;
+    }
+
+    std::FILE* output = nullptr;
+    if (!exportPath.empty() && !(output = std::fopen(exportPath.c_str(), "wb")))
+    {
+        std::fprintf(stderr, "cannot create %s\n", exportPath.c_str());
+        return 1;
+    }
+
+    int status = 0;
+    if (selfPlayGames > 0)
+    {
+        Endgames::init();
+        const auto        start = std::chrono::steady_clock::now();
+        SelfPlay          selfPlay(selfPlayGames, nodes, randomPlies, output);
+        const ImportStats stats = selfPlay.run(threads);
+        std::fflush(output);
+        printStats(stats, secondsSince(start), threads, static_cast<size_t>(std::ftell(output)));
+    }
+    else
+    {
+        MappedFile file;
+        if (!file.open(input))
+        {
+            std::fprintf(stderr, "cannot open %s\n", input.c_str());
+            return 1;
+        }
+        file.adviseSequential();
+
+        const auto        start = std::chrono::steady_clock::now();
+        Importer          importer(file.view(), maxErrors, output);
+        const ImportStats stats = importer.run(threads);
+        printStats(stats, secondsSince(start), threads, file.size());
+        status = stats.rejected == 0 ? 0 : 1;
+    }
+
+    if (output && std::fclose(output) != 0)
+    {
+        std::fprintf(stderr, "cannot write %s\n", exportPath.c_str());
+        return 1;
+    }
+    return status;
+}
@@ -0,0 +1,311 @@
+// Moteur UCI sans interface graphique : lit les commandes sur l'entrée standard, répond sur la sortie standard.
+//
+//   uci, isready, ucinewgame, setoption name <nom> [value <valeur>], position [startpos | fen <fen>] [moves <coups>],
+//   go [wtime btime winc binc movestogo depth nodes movetime infinite ponder], ponderhit, stop, quit
+//   et, pour le débogage : d (affiche la FEN de la position courante)
+//
+// Options : Hash, Threads, MultiPV, Move Overhead, EvalFile (réseau NNUE, vide = évaluation classique), Ponder.
+// La recherche tourne sur son propre thread : la boucle de lecture reste disponible pour stop, ponderhit et isready.
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "Chess/AI/Endgames.hpp"
+#include "Chess/AI/Nnue.hpp"
+#include "Chess/AI/Search.hpp"
+#include "Chess/AI/TranspositionTable.hpp"
+#include "Chess/Core/Fen.hpp"
+#include "Chess/Core/MoveGen.hpp"
+
+namespace {
+
+// Le thread de recherche (info, bestmove) et la boucle de lecture (readyok) écrivent tous deux : une ligne à la fois
+std::mutex g_outputMutex;
+
+void send(const std::string& line)
+{
+    std::lock_guard<std::mutex> lock(g_outputMutex);
+    std::fwrite(line.data(), 1, line.size(), stdout);
+    std::fputc('\n', stdout);
+    std::fflush(stdout);
+}
+
+// Valeur d'une option numérique : false si ce n'est pas un nombre en entier (lettres, débordement...)
+bool parseSpin(const std::string& text, int& value)
+{
+    const char* const end    = text.data() + text.size();
+    const auto [next, error] = std::from_chars(text.data(), end, value);
+    return error == std::errc() && next == end;
+}
+
+// "cp 35", ou "mate 3" / "mate -2" en coups (pas en demi-coups)
+std::string scoreToUci(int score)
+{
+    if (score >= VALUE_MATE_IN_MAX_PLY)
+        return "mate " + std::to_string((VALUE_MATE - score + 1) / 2);
+    if (score <= VALUE_MATED_IN_MAX_PLY)
+        return "mate -" + std::to_string((VALUE_MATE + score) / 2);
+    return "cp " + std::to_string(score);
+}
+
+// Coup en notation UCI parmi les coups légaux ; Move::none() s'il n'en fait pas partie
+Move parseMove(const BoardState& board, const std::string& text)
+{
+    MoveList moves;
+    generateLegalMoves(board, moves);
+    for (Move move : moves)
+    {
+        if (moveToUci(move) == text)
+            return move;
+    }
+    return Move::none();
+}
+
+class UciEngine {
+public:
+    UciEngine() { loadFen(m_position, START_FEN); }
+    ~UciEngine() { stopSearch(); }
+
+    void loop();
+
+private:
+    void setOption(std::istringstream& input);
+    void setPosition(std::istringstream& input);
+    void go(std::istringstream& input);
+    void stopSearch();
+    void reportIteration(const SearchInfo& info) const;
+
+    TranspositionTable m_tt{16};
+    Nnue::Network      m_network;
+    BoardState         m_position;
+    unsigned           m_threads        = 1;
+    int                m_multiPv        = 1;
+    int64_t            m_moveOverheadMs = 10;
+
+    std::thread       m_worker;
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_pondering{false}; // go ponder / go infinite : pas de bestmove avant ponderhit ou stop
+};
+
+void UciEngine::loop()
+{
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        std::istringstream input(line);
+        std::string        command;
+        input >> command;
+
+        if (command == "uci")
+        {
+            send("id name projet-prog-s4");
+            send("id author projet-prog-s4");
+            send("option name Hash type spin default 16 min 1 max 65536");
+            send("option name Threads type spin default 1 min 1 max 256");
+            send("option name MultiPV type spin default 1 min 1 max " + std::to_string(MAX_MULTIPV));
+            send("option name Move Overhead type spin default 10 min 0 max 5000");
+            send("option name EvalFile type string default <empty>");
+            send("option name Ponder type check default false");
+            send("uciok");
+        }
+        else if (command == "isready")
+            send("readyok");
+        else if (command == "ucinewgame")
+        {
+            stopSearch();
+            m_tt.clear();
+        }
+        else if (command == "setoption")
+            setOption(input);
+        else if (command == "position")
+            setPosition(input);
+        else if (command == "go")
+            go(input);
+        else if (command == "ponderhit")
+            m_pondering.store(false, std::memory_order_release);
+        else if (command == "stop")
+            stopSearch();
+        else if (command == "quit")
+            break;
+        else if (command == "d")
+            send(toFen(m_position));
+        else if (!command.empty())
+            send("info string unknown command: " + command);
+    }
+    stopSearch();
+}
+
+void UciEngine::setOption(std::istringstream& input)
+{
+    // Le nom peut contenir des espaces ("Move Overhead") : tout ce qui est entre "name" et "value"
+    std::string token, name, value;
+    input >> token;
+    while (input >> token && token != "value")
+        name += (name.empty() ? "" : " ") + token;
+    std::getline(input >> std::ws, value);
+
+    // Une valeur illisible laisse l'option telle quelle, les autres sont ramenées dans les bornes annoncées par "uci"
+    int number = 0;
+    if ((name == "Hash" || name == "Threads" || name == "MultiPV" || name == "Move Overhead") && !parseSpin(value, number))
+    {
+        send("info string invalid value for " + name + ": " + value);
+        return;
+    }
+
+    stopSearch();
+    if (name == "Hash")
+        m_tt.resize(static_cast<size_t>(std::clamp(number, 1, 65536)));
+    else if (name == "Threads")
+        m_threads = static_cast<unsigned>(std::clamp(number, 1, 256));
+    else if (name == "MultiPV")
+        m_multiPv = std::clamp(number, 1, MAX_MULTIPV);
+    else if (name == "Move Overhead")
+        m_moveOverheadMs = std::clamp(number, 0, 5000);
+    else if (name == "EvalFile")
+    {
+        if (value.empty() || value == "<empty>")
+            m_network.unload();
+        else if (!m_network.load(value))
+            send("info string cannot load network " + value + ", using the classical evaluation");
+        else
+            send("info string network " + value + " (" + Nnue::kernelName(m_network.kernel()) + ")");
+    }
+    else if (name != "Ponder")
+        send("info string unknown option: " + name);
+}
+
+void UciEngine::setPosition(std::istringstream& input)
+{
+    stopSearch();
+
+    std::string token, fen;
+    input >> token;
+    if (token == "startpos")
+    {
+        fen = START_FEN;
+        input >> token; // "moves", s'il y en a
+    }
+    else if (token == "fen")
+    {
+        while (input >> token && token != "moves")
+            fen += (fen.empty() ? "" : " ") + token;
+    }
+    else
+        return;
+
+    BoardState position;
+    if (!loadFen(position, fen))
+    {
+        send("info string invalid FEN: " + fen);
+        return;
+    }
+    // Les coups sont joués un par un sur la position : l'historique sert à détecter les répétitions pendant la recherche
+    while (input >> token)
+    {
+        const Move move = parseMove(position, token);
+        if (!move)
+        {
+            send("info string illegal move: " + token);
+            break;
+        }
+        position.makeMove(move);
+    }
+    m_position = position;
+}
+
+void UciEngine::go(std::istringstream& input)
+{
+    stopSearch();
+
+    SearchLimits limits;
+    limits.threads        = m_threads;
+    limits.multiPv        = m_multiPv;
+    limits.moveOverheadMs = m_moveOverheadMs;
+    if (m_network.isLoaded())
+        limits.network = &m_network;
+
+    bool        waitForStop = false;
+    std::string token;
+    while (input >> token)
+    {
+        if (token == "wtime")
+            input >> limits.timeMs[0];
+        else if (token == "btime")
+            input >> limits.timeMs[1];
+        else if (token == "winc")
+            input >> limits.incrementMs[0];
+        else if (token == "binc")
+            input >> limits.incrementMs[1];
+        else if (token == "movestogo")
+            input >> limits.movesToGo;
+        else if (token == "depth")
+            input >> limits.depth;
+        else if (token == "nodes")
+            input >> limits.nodes;
+        else if (token == "movetime")
+            input >> limits.movetimeMs;
+        else if (token == "infinite" || token == "ponder")
+            waitForStop = true;
+    }
+    limits.depth = std::clamp(limits.depth, 1, MAX_PLY - 1);
+
+    // go infinite se comporte comme une réflexion sur le temps adverse qui n'aurait jamais de ponderhit :
+    // la recherche ne rend pas son coup avant stop, même si elle a fini (mat trouvé, profondeur atteinte)
+    m_pondering.store(waitForStop, std::memory_order_relaxed);
+    if (waitForStop)
+        limits.ponder = &m_pondering;
+
+    m_stop.store(false, std::memory_order_relaxed);
+    m_worker = std::thread([this, limits, position = m_position] {
+        const SearchInfo result = searchParallel(position, limits, m_tt, m_stop, [this](const SearchInfo& info) { reportIteration(info); });
+        if (!result.bestMove)
+            send("bestmove 0000");
+        else if (result.ponderMove)
+            send("bestmove " + moveToUci(result.bestMove) + " ponder " + moveToUci(result.ponderMove));
+        else
+            send("bestmove " + moveToUci(result.bestMove));
+    });
+}
+
+void UciEngine::stopSearch()
+{
+    if (!m_worker.joinable())
+        return;
+
+    m_stop.store(true, std::memory_order_relaxed);
+    m_worker.join();
+}
+
+void UciEngine::reportIteration(const SearchInfo& info) const
+{
+    const uint64_t nps = info.timeMs > 0 ? info.nodes * 1000 / static_cast<uint64_t>(info.timeMs) : 0;
+    for (int i = 0; i < info.lineCount; ++i)
+    {
+        const PvLine& line = info.lines[i];
+        std::string   text = "info depth " + std::to_string(info.depth) + " seldepth " + std::to_string(info.selDepth) + " multipv "
+                           + std::to_string(i + 1) + " score " + scoreToUci(line.score) + " nodes " + std::to_string(info.nodes) + " nps "
+                           + std::to_string(nps) + " time " + std::to_string(info.timeMs) + " hashfull " + std::to_string(info.hashfull) + " pv";
+        for (int ply = 0; ply < line.length; ++ply)
+        {
+            text += ' ';
+            text += moveToUci(line.moves[ply]);
+        }
+        send(text);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    Endgames::init();
+
+    UciEngine engine;
+    engine.loop();
+    return 0;
+}